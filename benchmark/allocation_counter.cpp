@@ -0,0 +1,37 @@
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+/*
+ * Replaces the global allocation functions to count heap allocations, so
+ * benchmarks can report allocations per operation. Kept in its own
+ * translation unit so the replacements are never inlined into callers.
+ */
+static std::atomic<size_t> allocations{ 0 };
+
+size_t
+allocation_count()
+{
+  return allocations.load(std::memory_order_relaxed);
+}
+
+void*
+operator new(size_t size)
+{
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void* ptr = std::malloc(size ? size : 1))
+    return ptr;
+  throw std::bad_alloc();
+}
+
+void
+operator delete(void* ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void
+operator delete(void* ptr, size_t) noexcept
+{
+  std::free(ptr);
+}
@@ -0,0 +1,74 @@
+#include <benchmark/benchmark.h>
+
+#include <quicr/buffer_pool.h>
+#include <quicr/encode.h>
+
+// Heap allocations made by the benchmark binary, see allocation_counter.cpp
+size_t
+allocation_count();
+
+static quicr::messages::PublishDatagramView
+make_datagram(const std::vector<uint8_t>& payload)
+{
+  quicr::messages::PublishDatagramView datagram;
+  datagram.header.name = quicr::Name(0x10000000000000002000_name);
+  datagram.header.media_id = 1;
+  datagram.header.group_id = 2;
+  datagram.header.object_id = 3;
+  datagram.header.offset_and_fin = 1;
+  datagram.header.flags = 0;
+  datagram.media_type = quicr::messages::MediaType::RealtimeMedia;
+  datagram.media_data_length = payload.size();
+  datagram.media_data = payload;
+  return datagram;
+}
+
+static void
+report_allocations(benchmark::State& state, size_t start)
+{
+  state.counters["mallocs_per_object"] = benchmark::Counter(
+    static_cast<double>(allocation_count() - start) / state.iterations());
+}
+
+/*
+ * Encode a small object and hand the packet to the "transport", which frees
+ * it once sent.
+ */
+static void
+BufferPool_PublishSmall_Unpooled(benchmark::State& state)
+{
+  const std::vector<uint8_t> payload(100, 0xAB);
+  const auto datagram = make_datagram(payload);
+
+  const auto start = allocation_count();
+  for (auto _ : state) {
+    quicr::messages::MessageBuffer msg{ quicr::messages::wire_size(datagram) };
+    msg << datagram;
+    auto packet = msg.get();
+    benchmark::DoNotOptimize(packet.data());
+  }
+  report_allocations(state, start);
+}
+
+/*
+ * Same as above, but the packet is drawn from the pool and the "transport"
+ * releases it back to the pool once sent.
+ */
+static void
+BufferPool_PublishSmall_Pooled(benchmark::State& state)
+{
+  const std::vector<uint8_t> payload(100, 0xAB);
+  const auto datagram = make_datagram(payload);
+  quicr::messages::BufferPool pool;
+
+  const auto start = allocation_count();
+  for (auto _ : state) {
+    auto packet = quicr::messages::encode_segments(datagram, pool).gather();
+    benchmark::DoNotOptimize(packet.data());
+    pool.release(std::move(packet));
+  }
+  report_allocations(state, start);
+}
+
+BENCHMARK(BufferPool_PublishSmall_Unpooled)->Iterations(1'000'000);
+BENCHMARK(BufferPool_PublishSmall_Pooled)->Iterations(1'000'000);
@@ -0,0 +1,84 @@
+#include <benchmark/benchmark.h>
+
+#include <quicr/fanout_index.h>
+#include <quicr/namespace_matcher.h>
+
+#include <list>
+#include <set>
+
+// Heap allocations made by the benchmark binary, see allocation_counter.cpp
+size_t
+allocation_count();
+
+namespace {
+struct Remote
+{
+  uint64_t subscribe_id;
+  uint64_t context_id;
+  uint64_t stream_id;
+
+  bool operator==(const Remote&) const = default;
+  auto operator<=>(const Remote&) const = default;
+};
+
+const quicr::Namespace subscribed{ 0xA11CEE00F00001000000000000000000_name,
+                                   80 };
+const quicr::Name published = 0xA11CEE00F00001000000000012340001_name;
+}
+
+static void
+report_allocations(benchmark::State& state, size_t start)
+{
+  state.counters["mallocs_per_object"] = benchmark::Counter(
+    static_cast<double>(allocation_count() - start) / state.iterations());
+}
+
+/*
+ * Fan an object out to every subscriber of its namespace.
+ */
+static void
+FanoutIndex_ForEach(benchmark::State& state)
+{
+  quicr::FanoutIndex<Remote> index;
+  for (uint64_t i = 0; i < static_cast<uint64_t>(state.range(0)); ++i)
+    index.add(subscribed, { i, i, 1 });
+
+  const auto start = allocation_count();
+  for (auto _ : state) {
+    uint64_t sent = 0;
+    index.for_each(published, [&](const Remote& remote) {
+      sent += remote.context_id;
+    });
+    benchmark::DoNotOptimize(sent);
+  }
+  report_allocations(state, start);
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Copying the subscribers out into a list, as the relay used to
+static void
+FanoutIndex_ForEach_CopyList(benchmark::State& state)
+{
+  quicr::NamespaceMatcher<std::set<Remote>> index;
+  for (uint64_t i = 0; i < static_cast<uint64_t>(state.range(0)); ++i)
+    index[subscribed].insert({ i, i, 1 });
+
+  const auto start = allocation_count();
+  for (auto _ : state) {
+    std::list<Remote> list;
+    index.for_each_match(published, [&](const auto&, const auto& remotes) {
+      for (const auto& remote : remotes)
+        list.push_back(remote);
+    });
+
+    uint64_t sent = 0;
+    for (const auto& remote : list)
+      sent += remote.context_id;
+    benchmark::DoNotOptimize(sent);
+  }
+  report_allocations(state, start);
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(FanoutIndex_ForEach)->Arg(10)->Arg(1000);
+BENCHMARK(FanoutIndex_ForEach_CopyList)->Arg(10)->Arg(1000);
@@ -20,6 +20,16 @@ HexEndec_Decode128_to_4x32(benchmark::State& state)
   }
 }
 
+static void
+HexEndec_DecodeName128_to_4x32(benchmark::State& state)
+{
+  quicr::HexEndec<128, 32, 32, 32, 32> format;
+  quicr::Name name = 0xFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF_name;
+  for (auto _ : state) {
+    format.Decode(name);
+  }
+}
+
 static void
 HexEndec_Encode4x16_to_64(benchmark::State& state)
 {
@@ -40,6 +50,7 @@ HexEndec_Decode64_to_4x16(benchmark::State& state)
 
 BENCHMARK(HexEndec_Encode4x32_to_128);
 BENCHMARK(HexEndec_Decode128_to_4x32);
+BENCHMARK(HexEndec_DecodeName128_to_4x32);
 BENCHMARK(HexEndec_Encode4x16_to_64);
 BENCHMARK(HexEndec_Decode64_to_4x16);
 
@@ -69,5 +80,35 @@ HexEndec_RealDecode(benchmark::State& state)
   }
 }
 
+static void
+HexEndec_RealEncodeName(benchmark::State& state)
+{
+  quicr::HexEndec<128, 24, 8, 24, 8, 16, 48> format;
+  auto time = std::time(0);
+  const uint32_t orgId = 0x00A11CEE;
+  const uint8_t appId = 0x00;
+  const uint32_t confId = 0x00F00001;
+  const uint8_t mediaType = 0x00 | 0x1;
+  const uint16_t clientId = 0xFFFF;
+  const uint64_t uniqueId = time;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+      format.EncodeName(orgId, appId, confId, mediaType, clientId, uniqueId));
+  }
+}
+
+static void
+HexEndec_RealDecodeName(benchmark::State& state)
+{
+  quicr::HexEndec<128, 24, 8, 24, 8, 16, 48> format;
+  quicr::Name qname = 0xA11CEE00F00001000000000000000000_name;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(qname);
+    benchmark::DoNotOptimize(format.DecodeName(qname));
+  }
+}
+
 BENCHMARK(HexEndec_RealEncode);
 BENCHMARK(HexEndec_RealDecode);
+BENCHMARK(HexEndec_RealEncodeName);
+BENCHMARK(HexEndec_RealDecodeName);
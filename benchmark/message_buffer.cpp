@@ -79,3 +79,171 @@ BENCHMARK(MessageBuffer_PushBack32);
 BENCHMARK(MessageBuffer_PushBack64);
 BENCHMARK(MessageBuffer_PushBackVector);
 BENCHMARK(MessageBuffer_WriteName);
+
+static void
+MessageBuffer_DecodeDatagram(benchmark::State& state)
+{
+  quicr::messages::PublishDatagram datagram;
+  datagram.header = { 0x1000, 0xA11CEE00F00001000000000000000000_name,
+                      0x0100, 0x0010,
+                      0x0001, 0x00 };
+  datagram.media_type = quicr::messages::MediaType::RealtimeMedia;
+  datagram.media_data.resize(state.range(0));
+  std::generate(
+    datagram.media_data.begin(), datagram.media_data.end(), std::rand);
+  datagram.media_data_length = datagram.media_data.size();
+
+  quicr::messages::MessageBuffer encoded;
+  encoded << datagram;
+  const auto encoded_bytes = encoded.get();
+
+  for (auto _ : state) {
+    quicr::messages::MessageBuffer buffer(encoded_bytes);
+    quicr::messages::PublishDatagram out;
+    buffer >> out;
+    benchmark::DoNotOptimize(out);
+  }
+
+  state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK(MessageBuffer_DecodeDatagram)
+  ->DenseRange(100, 1200, 100)
+  ->Complexity(benchmark::oN);
+
+/*
+ * Decode a stream where every other packet is truncated, as seen under a
+ * malformed packet flood, with the throwing and non-throwing decoders.
+ */
+static std::vector<std::vector<uint8_t>>
+make_malformed_stream()
+{
+  quicr::messages::PublishDatagram datagram;
+  datagram.header = { 0x1000, 0xA11CEE00F00001000000000000000000_name,
+                      0x0100, 0x0010,
+                      0x0001, 0x00 };
+  datagram.media_type = quicr::messages::MediaType::RealtimeMedia;
+  datagram.media_data.resize(200);
+  datagram.media_data_length = datagram.media_data.size();
+
+  quicr::messages::MessageBuffer encoded;
+  encoded << datagram;
+  const auto packet = encoded.get();
+
+  std::vector<std::vector<uint8_t>> stream;
+  for (int i = 0; i < 64; ++i) {
+    stream.push_back(packet);
+    stream.emplace_back(packet.begin(), packet.begin() + 30);
+  }
+  return stream;
+}
+
+static void
+MessageBuffer_DecodeMalformed_Throwing(benchmark::State& state)
+{
+  const auto stream = make_malformed_stream();
+  size_t dropped = 0;
+
+  for (auto _ : state) {
+    for (const auto& packet : stream) {
+      quicr::messages::MessageBufferView view{ packet };
+      quicr::messages::PublishDatagramView out;
+      try {
+        view >> out;
+        benchmark::DoNotOptimize(out);
+      } catch (const quicr::messages::MessageBuffer::ReadException&) {
+        ++dropped;
+      }
+    }
+  }
+
+  benchmark::DoNotOptimize(dropped);
+  state.SetItemsProcessed(state.iterations() * stream.size());
+}
+
+static void
+MessageBuffer_DecodeMalformed_TryDecode(benchmark::State& state)
+{
+  const auto stream = make_malformed_stream();
+  size_t dropped = 0;
+
+  for (auto _ : state) {
+    for (const auto& packet : stream) {
+      quicr::messages::MessageBufferView view{ packet };
+      quicr::messages::PublishDatagramView out;
+      if (try_decode(view, out) != quicr::messages::DecodeStatus::Ok) {
+        ++dropped;
+        continue;
+      }
+      benchmark::DoNotOptimize(out);
+    }
+  }
+
+  benchmark::DoNotOptimize(dropped);
+  state.SetItemsProcessed(state.iterations() * stream.size());
+}
+
+BENCHMARK(MessageBuffer_DecodeMalformed_Throwing);
+BENCHMARK(MessageBuffer_DecodeMalformed_TryDecode);
+
+/*
+ * Publish 40 byte objects, as cmd/forty does, either one per transport
+ * payload or coalesced into batches. Reports transport payloads per second
+ * alongside objects per second.
+ */
+static quicr::messages::PublishDatagramView
+make_forty_byte_datagram(const std::vector<uint8_t>& payload)
+{
+  quicr::messages::PublishDatagramView datagram;
+  datagram.header = { 0x1000, 0xA11CEE00F00001000000000000000000_name,
+                      0x0100, 0x0010,
+                      0x0001, 0x00 };
+  datagram.media_type = quicr::messages::MediaType::RealtimeMedia;
+  datagram.media_data_length = payload.size();
+  datagram.media_data = payload;
+  return datagram;
+}
+
+static void
+MessageBuffer_Publish40_Unbatched(benchmark::State& state)
+{
+  const std::vector<uint8_t> payload(40, 0xAB);
+  const auto datagram = make_forty_byte_datagram(payload);
+  size_t packets = 0;
+
+  for (auto _ : state) {
+    auto packet = quicr::messages::encode_segments(datagram).gather();
+    benchmark::DoNotOptimize(packet.data());
+    ++packets;
+  }
+
+  state.SetItemsProcessed(state.iterations());
+  state.counters["packets"] =
+    benchmark::Counter(packets, benchmark::Counter::kIsRate);
+}
+
+static void
+MessageBuffer_Publish40_Batched(benchmark::State& state)
+{
+  const std::vector<uint8_t> payload(40, 0xAB);
+  const auto datagram = make_forty_byte_datagram(payload);
+  quicr::messages::MessageBatch batch;
+  size_t packets = 0;
+
+  for (auto _ : state) {
+    auto message = quicr::messages::encode_segments(datagram).gather();
+    if (!batch.fits(message.size())) {
+      auto packet = batch.flush();
+      benchmark::DoNotOptimize(packet.data());
+      ++packets;
+    }
+    batch.append(message);
+  }
+
+  state.SetItemsProcessed(state.iterations());
+  state.counters["packets"] =
+    benchmark::Counter(packets, benchmark::Counter::kIsRate);
+}
+
+BENCHMARK(MessageBuffer_Publish40_Unbatched);
+BENCHMARK(MessageBuffer_Publish40_Batched);
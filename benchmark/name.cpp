@@ -1,6 +1,12 @@
 #include <benchmark/benchmark.h>
 
+#include <quicr/name_map.h>
 #include <quicr/quicr_name.h>
+#include <quicr/quicr_namespace.h>
+#include <algorithm>
+#include <map>
+#include <random>
+#include <unordered_map>
 #include <vector>
 
 static void
@@ -102,6 +108,16 @@ Name_ToHex(benchmark::State& state)
   }
 }
 
+static void
+Name_ToHexBuffer(benchmark::State& state)
+{
+  quicr::Name name = 0xFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF_name;
+  char buffer[quicr::Name::hex_size];
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(name.to_hex(buffer));
+  }
+}
+
 BENCHMARK(Name_ConstructFromHexString);
 BENCHMARK(Name_ConstructFromHexStringView);
 BENCHMARK(Name_ConstructFromVector);
@@ -112,6 +128,7 @@ BENCHMARK(Name_RightShift);
 BENCHMARK(Name_Add);
 BENCHMARK(Name_Sub);
 BENCHMARK(Name_ToHex);
+BENCHMARK(Name_ToHexBuffer);
 
 constexpr quicr::Name object_id_mask = 0x00000000000000000000000000001111_name;
 constexpr quicr::Name group_id_mask = 0x00000000000000000000111111110000_name;
@@ -128,3 +145,79 @@ Name_RealArithmetic(benchmark::State& state)
 }
 
 BENCHMARK(Name_RealArithmetic);
+
+static void
+Namespace_Contains(benchmark::State& state)
+{
+  quicr::Namespace ns(0xA11CEE00F00001000000000000000000_name, 80);
+  quicr::Name name = 0xA11CEE00F00001000000000000000000_name;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(ns);
+    benchmark::DoNotOptimize(ns.contains(++name));
+  }
+}
+
+BENCHMARK(Namespace_Contains);
+
+// Names as a relay sees them: a few shared high words, random low words
+static std::vector<quicr::Name>
+make_names(size_t count)
+{
+  std::mt19937_64 rng(0x5EED);
+  std::vector<quicr::Name> names;
+  names.reserve(count);
+  for (size_t i = 0; i < count; ++i)
+    names.emplace_back(0xA11CEE00F0000100 | (rng() & 0xFF), rng());
+
+  return names;
+}
+
+template<typename Map>
+static void
+Name_MapInsert(benchmark::State& state)
+{
+  const auto names = make_names(state.range(0));
+  for (auto _ : state) {
+    Map map;
+    for (const auto& name : names)
+      map.try_emplace(name, 0);
+    benchmark::DoNotOptimize(map);
+  }
+  state.SetItemsProcessed(state.iterations() * names.size());
+}
+
+template<typename Map>
+static void
+Name_MapLookup(benchmark::State& state)
+{
+  auto names = make_names(state.range(0));
+  Map map;
+  for (const auto& name : names)
+    map.try_emplace(name, 0);
+
+  std::shuffle(names.begin(), names.end(), std::mt19937_64(0x5EED));
+  for (auto _ : state) {
+    for (const auto& name : names)
+      benchmark::DoNotOptimize(map.find(name));
+  }
+  state.SetItemsProcessed(state.iterations() * names.size());
+}
+
+BENCHMARK(Name_MapInsert<std::map<quicr::Name, uint64_t>>)
+  ->Arg(1'000'000)
+  ->Unit(benchmark::kMillisecond);
+BENCHMARK(Name_MapInsert<std::unordered_map<quicr::Name, uint64_t>>)
+  ->Arg(1'000'000)
+  ->Unit(benchmark::kMillisecond);
+BENCHMARK(Name_MapLookup<std::map<quicr::Name, uint64_t>>)
+  ->Arg(1'000'000)
+  ->Unit(benchmark::kMillisecond);
+BENCHMARK(Name_MapLookup<std::unordered_map<quicr::Name, uint64_t>>)
+  ->Arg(1'000'000)
+  ->Unit(benchmark::kMillisecond);
+BENCHMARK(Name_MapInsert<quicr::NameMap<uint64_t>>)
+  ->Arg(1'000'000)
+  ->Unit(benchmark::kMillisecond);
+BENCHMARK(Name_MapLookup<quicr::NameMap<uint64_t>>)
+  ->Arg(1'000'000)
+  ->Unit(benchmark::kMillisecond);
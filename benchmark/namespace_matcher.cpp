@@ -0,0 +1,127 @@
+#include <benchmark/benchmark.h>
+
+#include <quicr/namespace_matcher.h>
+#include <quicr/namespace_trie.h>
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <vector>
+
+// Subscriptions under one organisation, spread evenly over a number of
+// prefix lengths between 64 and 128 bits
+static std::vector<quicr::Namespace>
+make_subscriptions(size_t count, size_t lengths)
+{
+  std::mt19937_64 rng(0x5EED);
+  std::vector<quicr::Namespace> namespaces;
+  namespaces.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    const quicr::Name name(0xA11CEE00F0000000 | (rng() & 0xFFFFF), rng());
+    const auto length = 64 + (i % lengths) * (64 / lengths);
+    namespaces.emplace_back(name, static_cast<uint8_t>(length));
+  }
+
+  return namespaces;
+}
+
+template<typename Index>
+static void
+NamespaceIndex_FindMatches(benchmark::State& state)
+{
+  const auto namespaces = make_subscriptions(state.range(0), state.range(1));
+  Index index;
+  for (const auto& ns : namespaces)
+    index[ns] = 1;
+
+  std::mt19937_64 rng(0x5EED);
+  size_t i = 0;
+  for (auto _ : state) {
+    uint64_t found = 0;
+    const auto name = namespaces[i++ % namespaces.size()].name() + (rng() >> 1);
+    index.for_each_match(
+      name, [&](const quicr::Namespace&, uint64_t& value) { found += value; });
+    benchmark::DoNotOptimize(found);
+  }
+}
+
+BENCHMARK(NamespaceIndex_FindMatches<quicr::NamespaceMatcher<uint64_t>>)
+  ->ArgsProduct({ { 10'000, 1'000'000 }, { 2, 4, 16 } });
+BENCHMARK(NamespaceIndex_FindMatches<quicr::NamespaceTrie<uint64_t>>)
+  ->ArgsProduct({ { 10'000, 1'000'000 }, { 2, 4, 16 } });
+
+// Publish intents of one organisation, one /80 namespace per publisher, and
+// objects named under them, or under an unknown publisher one time in ten
+struct PublishLoad
+{
+  std::vector<quicr::Namespace> intents;
+  std::vector<quicr::Name> objects;
+};
+
+static PublishLoad
+make_publish_load(size_t intents, size_t objects)
+{
+  std::mt19937_64 rng(0x5EED);
+  PublishLoad load;
+  for (size_t i = 0; i < intents; ++i)
+    load.intents.emplace_back(
+      quicr::Name(0xA11CEE00F0000000 | (rng() & 0xFFFFFFF), rng()), 80);
+
+  for (size_t i = 0; i < objects; ++i) {
+    auto name = load.intents[rng() % intents].name() + (rng() & 0xFFFFFFFFFF);
+    if (i % 10 == 0)
+      name = name ^ quicr::Name(0x1, 0);
+    load.objects.push_back(name);
+  }
+
+  return load;
+}
+
+static void
+PublishIntent_Authorize(benchmark::State& state)
+{
+  const auto load = make_publish_load(state.range(0), 100'000);
+  quicr::NamespaceMatcher<uint64_t> publish_namespaces;
+  for (const auto& ns : load.intents)
+    publish_namespaces[ns] = 1;
+
+  for (auto _ : state) {
+    size_t authorized = 0;
+    for (const auto& name : load.objects)
+      authorized += publish_namespaces.matches(name);
+    benchmark::DoNotOptimize(authorized);
+  }
+  state.SetItemsProcessed(state.iterations() * load.objects.size());
+}
+
+// Scanning every intent, as QuicRServer::handle_publish used to
+static void
+PublishIntent_AuthorizeLinearScan(benchmark::State& state)
+{
+  const auto load = make_publish_load(state.range(0), 100'000);
+  std::map<quicr::Namespace, uint64_t> publish_namespaces;
+  for (const auto& ns : load.intents)
+    publish_namespaces[ns] = 1;
+
+  for (auto _ : state) {
+    size_t authorized = 0;
+    for (const auto& name : load.objects)
+      authorized += std::any_of(
+        publish_namespaces.begin(),
+        publish_namespaces.end(),
+        [&name](const auto& ns) { return ns.first.contains(name); });
+    benchmark::DoNotOptimize(authorized);
+  }
+  state.SetItemsProcessed(state.iterations() * load.objects.size());
+}
+
+BENCHMARK(PublishIntent_Authorize)
+  ->Arg(1'000)
+  ->Arg(10'000)
+  ->Arg(100'000)
+  ->Unit(benchmark::kMillisecond);
+// 100k intents takes minutes per iteration, and scales linearly from 10k
+BENCHMARK(PublishIntent_AuthorizeLinearScan)
+  ->Arg(1'000)
+  ->Arg(10'000)
+  ->Unit(benchmark::kMillisecond);
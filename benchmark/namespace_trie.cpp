@@ -0,0 +1,67 @@
+#include <benchmark/benchmark.h>
+
+#include <quicr/namespace_trie.h>
+
+#include <map>
+#include <random>
+#include <vector>
+
+// Subscriptions as a relay sees them: a few hundred conferences, each with
+// subscribers to the whole conference and to single participants
+static std::vector<quicr::Namespace>
+make_subscriptions(size_t count)
+{
+  std::mt19937_64 rng(0x5EED);
+  std::vector<quicr::Namespace> namespaces;
+  for (size_t i = 0; i < count; ++i) {
+    const quicr::Name name(0xA11CEE00F0000000 | (rng() & 0xFFF), rng());
+    namespaces.emplace_back(name, i % 2 ? 64 : 80);
+  }
+
+  return namespaces;
+}
+
+static void
+NamespaceTrie_FindMatches(benchmark::State& state)
+{
+  const auto namespaces = make_subscriptions(state.range(0));
+  quicr::NamespaceTrie<uint64_t> trie;
+  for (const auto& ns : namespaces)
+    trie[ns] = 1;
+
+  size_t i = 0;
+  for (auto _ : state) {
+    uint64_t found = 0;
+    const auto name = namespaces[i % namespaces.size()].name() + i;
+    ++i;
+    trie.for_each_match(
+      name, [&](const quicr::Namespace&, uint64_t& value) { found += value; });
+    benchmark::DoNotOptimize(found);
+  }
+}
+
+// Probing a map for every prefix length, as cmd/really used to
+static void
+NamespaceTrie_FindMatchesPrefixMaps(benchmark::State& state)
+{
+  const auto namespaces = make_subscriptions(state.range(0));
+  std::vector<std::map<quicr::Name, uint64_t>> maps(129);
+  for (const auto& ns : namespaces)
+    maps[ns.length()][ns.name()] = 1;
+
+  size_t i = 0;
+  for (auto _ : state) {
+    uint64_t found = 0;
+    const auto name = namespaces[i % namespaces.size()].name() + i;
+    ++i;
+    for (int len = 0; len <= 128; ++len) {
+      const quicr::Namespace prefix(name, len);
+      if (auto it = maps[len].find(prefix.name()); it != maps[len].end())
+        found += it->second;
+    }
+    benchmark::DoNotOptimize(found);
+  }
+}
+
+BENCHMARK(NamespaceTrie_FindMatches)->Arg(1000)->Arg(100000);
+BENCHMARK(NamespaceTrie_FindMatchesPrefixMaps)->Arg(1000)->Arg(100000);
@@ -0,0 +1,178 @@
+#include <benchmark/benchmark.h>
+
+#include <quicr/quicr_server.h>
+
+#include <memory>
+
+namespace {
+// Sends nothing, handing each packet back to the server's pool as a
+// transport does once it is sent
+struct DiscardTransport : public qtransport::ITransport
+{
+  qtransport::TransportStatus status() const override
+  {
+    return qtransport::TransportStatus::Ready;
+  }
+
+  qtransport::TransportContextId start() override { return 0; }
+
+  qtransport::StreamId createStream(const qtransport::TransportContextId&,
+                                    bool) override
+  {
+    return 0;
+  }
+
+  void close(const qtransport::TransportContextId&) override {}
+  void closeStream(const qtransport::TransportContextId&,
+                   qtransport::StreamId) override
+  {
+  }
+
+  qtransport::TransportError enqueue(const qtransport::TransportContextId&,
+                                     const qtransport::StreamId&,
+                                     std::vector<uint8_t>&& bytes) override
+  {
+    pool->release(std::move(bytes));
+    return qtransport::TransportError::None;
+  }
+
+  std::optional<std::vector<uint8_t>> dequeue(
+    const qtransport::TransportContextId&,
+    const qtransport::StreamId&) override
+  {
+    return std::nullopt;
+  }
+
+  quicr::messages::BufferPool* pool{ nullptr };
+};
+
+struct NullDelegate : public quicr::ServerDelegate
+{
+  void onPublishIntent(const quicr::Namespace&,
+                       const std::string&,
+                       bool,
+                       const std::string&,
+                       quicr::bytes&&) override
+  {
+  }
+
+  void onPublishIntentEnd(const quicr::Namespace&,
+                          const std::string&,
+                          quicr::bytes&&) override
+  {
+  }
+
+  void onPublisherObject(const qtransport::TransportContextId&,
+                         const qtransport::StreamId&,
+                         bool,
+                         quicr::messages::PublishDatagram&&) override
+  {
+  }
+};
+
+quicr::messages::PublishDatagram
+make_datagram(size_t payload_size)
+{
+  quicr::messages::PublishDatagram datagram;
+  datagram.header.name = 0x10000000000000002000_name;
+  datagram.header.media_id = 1;
+  datagram.header.group_id = 2;
+  datagram.header.object_id = 3;
+  datagram.header.offset_and_fin = 1;
+  datagram.header.flags = 0;
+  datagram.media_type = quicr::messages::MediaType::RealtimeMedia;
+  datagram.media_data_length = payload_size;
+  datagram.media_data.resize(payload_size, 0xAB);
+  return datagram;
+}
+
+struct Fixture
+{
+  Fixture()
+    : transport{ std::make_shared<DiscardTransport>() }
+    , server{ transport, delegate, logger }
+  {
+    transport->pool = &server.buffer_pool;
+  }
+
+  NullDelegate delegate;
+  qtransport::LogHandler logger;
+  std::shared_ptr<DiscardTransport> transport;
+  quicr::QuicRServer server;
+};
+}
+
+/*
+ * Fan a 1200 byte object out to each subscriber.
+ */
+static void
+ServerFanout_SendNamedObject(benchmark::State& state)
+{
+  Fixture fixture;
+  const auto datagram = make_datagram(1200);
+
+  for (auto _ : state) {
+    for (int64_t i = 0; i < state.range(0); ++i)
+      fixture.server.sendNamedObject(i, 1, 0, false, datagram);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void
+ServerFanout_EncodeOnce(benchmark::State& state)
+{
+  Fixture fixture;
+  const auto datagram = make_datagram(1200);
+
+  for (auto _ : state) {
+    const auto encoded = fixture.server.encodeNamedObject(datagram);
+    for (int64_t i = 0; i < state.range(0); ++i)
+      fixture.server.sendEncodedObject(i, 1, 0, false, encoded.view().data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(ServerFanout_SendNamedObject)->Arg(500);
+BENCHMARK(ServerFanout_EncodeOnce)->Arg(500);
+
+/*
+ * Relay a received 1200 byte object to each subscriber.
+ */
+static void
+ServerFanout_ForwardDecoded(benchmark::State& state)
+{
+  Fixture fixture;
+  const auto received = fixture.server.encodeNamedObject(make_datagram(1200));
+
+  for (auto _ : state) {
+    quicr::messages::MessageBufferView msg{ received.view() };
+    quicr::messages::PublishDatagram datagram;
+    quicr::messages::try_decode(msg, datagram);
+
+    const auto encoded = fixture.server.encodeNamedObject(datagram);
+    for (int64_t i = 0; i < state.range(0); ++i)
+      fixture.server.sendEncodedObject(i, 1, 0, false, encoded.view().data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void
+ServerFanout_ForwardBytes(benchmark::State& state)
+{
+  Fixture fixture;
+  const auto received = fixture.server.encodeNamedObject(make_datagram(1200));
+
+  for (auto _ : state) {
+    const auto encoded = received.view().data();
+    quicr::messages::Header header;
+    quicr::messages::try_peek_publish_header(encoded, header);
+    benchmark::DoNotOptimize(header);
+
+    for (int64_t i = 0; i < state.range(0); ++i)
+      fixture.server.sendEncodedObject(i, 1, 0, false, encoded);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(ServerFanout_ForwardDecoded)->Arg(1)->Arg(500);
+BENCHMARK(ServerFanout_ForwardBytes)->Arg(1)->Arg(500);
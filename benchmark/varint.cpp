@@ -0,0 +1,205 @@
+#include <benchmark/benchmark.h>
+
+#include <quicr/encode.h>
+#include <quicr/varint.h>
+
+#include <array>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+/*
+ * Byte at a time codec that quicr::varint replaced, kept as the baseline.
+ */
+size_t
+legacy_encode(uint64_t val, uint8_t* out)
+{
+  if (val < ((uint64_t)1 << 7)) {
+    out[0] = uint8_t(((val >> 0) & 0x7F)) | 0x00;
+    return 1;
+  }
+
+  if (val < ((uint64_t)1 << 14)) {
+    out[0] = uint8_t(((val >> 8) & 0x3F) | 0x80);
+    out[1] = uint8_t((val >> 0) & 0xFF);
+    return 2;
+  }
+
+  if (val < ((uint64_t)1 << 29)) {
+    out[0] = uint8_t(((val >> 24) & 0x1F) | 0x80 | 0x40);
+    out[1] = uint8_t((val >> 16) & 0xFF);
+    out[2] = uint8_t((val >> 8) & 0xFF);
+    out[3] = uint8_t((val >> 0) & 0xFF);
+    return 4;
+  }
+
+  out[0] = uint8_t(((val >> 56) & 0x0F) | 0x80 | 0x40 | 0x20);
+  for (int i = 1; i < 8; ++i)
+    out[i] = uint8_t((val >> (56 - 8 * i)) & 0xFF);
+  return 8;
+}
+
+uint64_t
+legacy_decode(const uint8_t*& in)
+{
+  const uint8_t first = in[0];
+
+  if ((first & (0x80)) == 0) {
+    return *in++ & 0x7F;
+  }
+
+  if ((first & (0x80 | 0x40)) == 0x80) {
+    uint64_t val = *in++ & 0x3F;
+    return (val << 8) + *in++;
+  }
+
+  if ((first & (0x80 | 0x40 | 0x20)) == (0x80 | 0x40)) {
+    uint64_t val = *in++ & 0x1F;
+    for (int i = 0; i < 3; ++i)
+      val = (val << 8) + *in++;
+    return val;
+  }
+
+  uint64_t val = *in++ & 0x0F;
+  for (int i = 0; i < 7; ++i)
+    val = (val << 8) + *in++;
+  return val;
+}
+
+constexpr size_t values_per_iteration = 1024;
+
+/*
+ * Values spread across the range of the size class given in bytes, or an
+ * even mix of all size classes when size_class is 0
+ */
+std::vector<uint64_t>
+make_values(int64_t size_class)
+{
+  if (size_class == 0) {
+    std::vector<uint64_t> values;
+    for (const auto& mixed_class : { 1, 2, 4, 8 }) {
+      auto class_values = make_values(mixed_class);
+      values.insert(values.end(),
+                    class_values.begin(),
+                    class_values.begin() + values_per_iteration / 4);
+    }
+
+    std::srand(0);
+    for (size_t i = values.size() - 1; i > 0; --i)
+      std::swap(values[i], values[std::rand() % (i + 1)]);
+    return values;
+  }
+
+  uint64_t low = 0;
+  uint64_t high = (1ull << 7) - 1;
+  switch (size_class) {
+    case 2:
+      low = 1ull << 7;
+      high = (1ull << 14) - 1;
+      break;
+    case 4:
+      low = 1ull << 14;
+      high = (1ull << 29) - 1;
+      break;
+    case 8:
+      low = 1ull << 29;
+      high = (1ull << 60) - 1;
+      break;
+  }
+
+  std::vector<uint64_t> values(values_per_iteration);
+  for (size_t i = 0; i < values.size(); ++i)
+    values[i] = low + (high - low) / values.size() * i;
+  return values;
+}
+}
+
+static void
+VarInt_LegacyEncode(benchmark::State& state)
+{
+  const auto values = make_values(state.range(0));
+  std::vector<uint8_t> out(values.size() * quicr::varint::max_size);
+
+  for (auto _ : state) {
+    uint8_t* it = out.data();
+    for (const auto& value : values)
+      it += legacy_encode(value, it);
+    benchmark::DoNotOptimize(out.data());
+  }
+
+  state.SetItemsProcessed(state.iterations() * values.size());
+}
+
+static void
+VarInt_Encode(benchmark::State& state)
+{
+  const auto values = make_values(state.range(0));
+  std::vector<uint8_t> out(values.size() * quicr::varint::max_size);
+
+  for (auto _ : state) {
+    uint8_t* it = out.data();
+    for (const auto& value : values)
+      it += quicr::varint::encode(value, it);
+    benchmark::DoNotOptimize(out.data());
+  }
+
+  state.SetItemsProcessed(state.iterations() * values.size());
+}
+
+static void
+VarInt_LegacyDecode(benchmark::State& state)
+{
+  const auto values = make_values(state.range(0));
+  std::vector<uint8_t> in(values.size() * quicr::varint::max_size);
+  for (size_t i = 0, offset = 0; i < values.size(); ++i)
+    offset += legacy_encode(values[i], in.data() + offset);
+
+  for (auto _ : state) {
+    const uint8_t* it = in.data();
+    for (size_t i = 0; i < values.size(); ++i)
+      benchmark::DoNotOptimize(legacy_decode(it));
+  }
+
+  state.SetItemsProcessed(state.iterations() * values.size());
+}
+
+static void
+VarInt_Decode(benchmark::State& state)
+{
+  const auto values = make_values(state.range(0));
+  std::vector<uint8_t> in(values.size() * quicr::varint::max_size);
+  for (size_t i = 0, offset = 0; i < values.size(); ++i)
+    offset += quicr::varint::encode(values[i], in.data() + offset);
+
+  for (auto _ : state) {
+    const uint8_t* it = in.data();
+    for (size_t i = 0; i < values.size(); ++i) {
+      const auto length = quicr::varint::length(*it);
+      benchmark::DoNotOptimize(quicr::varint::decode(it, length));
+      it += length;
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * values.size());
+}
+
+BENCHMARK(VarInt_LegacyEncode)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Arg(0);
+BENCHMARK(VarInt_Encode)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Arg(0);
+BENCHMARK(VarInt_LegacyDecode)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Arg(0);
+BENCHMARK(VarInt_Decode)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Arg(0);
+
+static void
+VarInt_EncodeHeader(benchmark::State& state)
+{
+  const quicr::messages::Header header{
+    0x1000, 0xA11CEE00F00001000000000000000000_name, 0x0100, 0x0010, 0x0001, 0
+  };
+
+  for (auto _ : state) {
+    quicr::messages::MessageBuffer buffer(64);
+    buffer << header;
+    benchmark::DoNotOptimize(buffer);
+  }
+}
+
+BENCHMARK(VarInt_EncodeHeader);
@@ -12,6 +12,7 @@
 #include <iostream>
 #include <mutex>
 #include <set>
+#include <span>
 #include <sstream>
 
 // Module-level variables used to control program execution
@@ -160,24 +161,34 @@ public:
   }
 
   virtual void onPublisherObject(
+    [[maybe_unused]] const qtransport::TransportContextId& context_id,
+    [[maybe_unused]] const qtransport::StreamId& stream_id,
+    [[maybe_unused]] bool use_reliable_transport,
+    [[maybe_unused]] quicr::messages::PublishDatagram&& datagram)
+  {
+    // Objects are forwarded undecoded, by onPublisherObjectBytes
+  }
+
+  virtual void onPublisherObjectBytes(
     const qtransport::TransportContextId& context_id,
     const qtransport::StreamId& stream_id,
     [[maybe_unused]] bool use_reliable_transport,
-    quicr::messages::PublishDatagram&& datagram)
+    const quicr::messages::Header& header,
+    std::span<const uint8_t> encoded)
   {
-    std::list<Subscriptions::Remote> list =
-      subscribeList.find(datagram.header.name);
-
-    for (auto dest : list) {
-
-      if (dest.context_id == context_id && dest.stream_id == stream_id) {
-        // split horizon - drop packets back to the source that originated the
-        // published object
-        continue;
-      }
-
-      server->sendNamedObject(dest.subscribe_id, false, datagram);
-    }
+    subscribeList.for_each(
+      header.name, [&](const Subscriptions::Remote& dest) {
+        if (dest.context_id == context_id) {
+          // split horizon - drop packets back to the source that originated
+          // the published object, on whichever of its streams
+          return;
+        }
+
+        // On a stream of its own for each stream of the publisher's, which
+        // sends each priority on a stream of its own
+        server->forwardEncodedObject(
+          dest.context_id, context_id, stream_id, false, encoded);
+      });
   }
 
   virtual void onUnsubscribe(const quicr::Namespace& quicr_namespace,
@@ -203,8 +214,8 @@ public:
   virtual void onSubscribe(
     const quicr::Namespace& quicr_namespace,
     const uint64_t& subscriber_id,
-    [[maybe_unused]] const qtransport::TransportContextId& context_id,
-    [[maybe_unused]] const qtransport::StreamId& stream_id,
+    const qtransport::TransportContextId& context_id,
+    const qtransport::StreamId& stream_id,
     [[maybe_unused]] const quicr::SubscribeIntent subscribe_intent,
     [[maybe_unused]] const std::string& origin_url,
     [[maybe_unused]] bool use_reliable_transport,
@@ -218,7 +229,9 @@ public:
 
     logger.log(qtransport::LogLevel::info, log_msg.str());
 
-    Subscriptions::Remote remote = { .subscribe_id = subscriber_id };
+    Subscriptions::Remote remote = { .subscribe_id = subscriber_id,
+                                     .context_id = context_id,
+                                     .stream_id = stream_id };
     subscribeList.add(quicr_namespace.name(), quicr_namespace.length(), remote);
 
     // respond with response
@@ -1,4 +1,3 @@
-#include <list>
 #include <set>
 #include <map>
 #include <vector>
@@ -7,14 +6,15 @@
 #include <transport/transport.h>
 #include <quicr/quicr_name.h>
 #include <quicr/quicr_namespace.h>
+#include <quicr/fanout_index.h>
 
 class Subscriptions {
 public:
 
   struct Remote {
-    uint64_t subscribe_id;
-    uint64_t context_id;
-    uint64_t stream_id;
+    uint64_t subscribe_id{ 0 };
+    uint64_t context_id{ 0 };
+    uint64_t stream_id{ 0 };
 
     bool operator==(const Remote &o) const {
       return subscribe_id == o.subscribe_id
@@ -38,11 +38,13 @@ public:
   
   void remove(const quicr::Name& name, const int len, const Remote& remote );
   
-  std::list<Remote> find(  const quicr::Name& name  ) ;
+  // Calls func(const Remote&) for each subscriber to name, without locking
+  template<typename Func>
+  void for_each( const quicr::Name& name, Func&& func ) const {
+    subscriptions.for_each( name, std::forward<Func>( func ) );
+  }
     
  private:
-  std::vector< std::map<quicr::Name,std::set<Remote>> > subscriptions;
+  quicr::FanoutIndex<Remote> subscriptions;
 
 };
-
-
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <quicr/mpmc_queue.h>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace quicr::messages {
+
+/**
+ * @brief Lock-free pool of packet buffers, recycled by size class.
+ *
+ * @details Buffers are plain vectors, so they can be moved into the transport
+ *          as is. acquire() returns an empty buffer with at least the
+ *          requested capacity, reusing a released buffer of the matching size
+ *          class when one is available. release() is the hook for returning a
+ *          buffer once its bytes are no longer needed, e.g. by the transport
+ *          after a send or by the receive path after a packet is decoded.
+ *
+ *          Requests larger than the biggest size class are not pooled.
+ */
+class BufferPool
+{
+public:
+  struct SizeClass
+  {
+    size_t buffer_size;
+    size_t max_buffers;
+  };
+
+  static constexpr std::array<SizeClass, 3> size_classes{ {
+    { 256, 4096 },    // Control messages and small objects
+    { 1536, 4096 },   // A full transport datagram
+    { 65536, 64 },    // Reassembled or stream objects
+  } };
+
+  BufferPool();
+  BufferPool(const BufferPool&) = delete;
+  BufferPool& operator=(const BufferPool&) = delete;
+
+  std::vector<uint8_t> acquire(size_t size);
+  void release(std::vector<uint8_t>&& buffer);
+
+private:
+  std::array<MPMCQueue<std::vector<uint8_t>>, size_classes.size()> _free;
+};
+
+/**
+ * @brief Releases a buffer to its pool once out of scope, however the scope
+ *        is left.
+ */
+class BufferRelease
+{
+public:
+  BufferRelease(BufferPool& pool, std::vector<uint8_t>& buffer)
+    : _pool{ pool }
+    , _buffer{ buffer }
+  {
+  }
+
+  BufferRelease(const BufferRelease&) = delete;
+  BufferRelease& operator=(const BufferRelease&) = delete;
+
+  ~BufferRelease() { _pool.release(std::move(_buffer)); }
+
+private:
+  BufferPool& _pool;
+  std::vector<uint8_t>& _buffer;
+};
+
+}
@@ -1,11 +1,14 @@
 #pragma once
 
+#include <quicr/buffer_pool.h>
 #include <quicr/message_buffer.h>
+#include <quicr/message_layout.h>
 #include <quicr/quicr_common.h>
 #include <quicr/quicr_name.h>
 #include <quicr/quicr_namespace.h>
 
 #include <random>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -21,6 +24,18 @@ namespace quicr::messages {
 uint64_t
 create_transaction_id();
 
+/*
+ * wire_size() returns the exact number of bytes operator<< appends for a
+ * message, so a MessageBuffer can be reserved once before encoding:
+ *
+ *   MessageBuffer msg{ wire_size(datagram) };
+ *   msg << datagram;
+ *
+ * The wire format of each message is described once by its MessageLayout,
+ * from which the encoder, decoder and wire_size() are generated. See
+ * message_layout.h.
+ */
+
 /*===========================================================================*/
 // Subscribe Message Types
 /*===========================================================================*/
@@ -33,21 +48,53 @@ struct Subscribe
   SubscribeIntent intent;
 };
 
+template<>
+struct MessageLayout<Subscribe>
+{
+  static constexpr std::tuple fields{
+    layout::tag<MessageType::Subscribe>,
+    layout::field<&Subscribe::transaction_id>,
+    layout::field<&Subscribe::quicr_namespace>,
+    layout::field_as<uint8_t, &Subscribe::intent>,
+  };
+};
+
 struct Unsubscribe
 {
   uint8_t version;
   quicr::Namespace quicr_namespace;
 };
 
+template<>
+struct MessageLayout<Unsubscribe>
+{
+  static constexpr std::tuple fields{
+    layout::tag<MessageType::Unsubscribe>,
+    layout::field<&Unsubscribe::quicr_namespace>,
+  };
+};
+
 MessageBuffer&
 operator<<(MessageBuffer& buffer, const Unsubscribe& msg);
 MessageBuffer&
 operator>>(MessageBuffer& buffer, Unsubscribe& msg);
+MessageBufferView&
+operator>>(MessageBufferView& buffer, Unsubscribe& msg);
+DecodeStatus
+try_decode(MessageBufferView& buffer, Unsubscribe& msg);
+size_t
+wire_size(const Unsubscribe& msg);
 
 MessageBuffer&
 operator<<(MessageBuffer& buffer, const Subscribe& msg);
 MessageBuffer&
 operator>>(MessageBuffer& buffer, Subscribe& msg);
+MessageBufferView&
+operator>>(MessageBufferView& buffer, Subscribe& msg);
+DecodeStatus
+try_decode(MessageBufferView& buffer, Subscribe& msg);
+size_t
+wire_size(const Subscribe& msg);
 
 struct SubscribeResponse
 {
@@ -64,10 +111,27 @@ struct SubscribeResponse
    */
 };
 
+template<>
+struct MessageLayout<SubscribeResponse>
+{
+  static constexpr std::tuple fields{
+    layout::tag<MessageType::SubscribeResponse>,
+    layout::field_as<uint8_t, &SubscribeResponse::response>,
+    layout::field<&SubscribeResponse::transaction_id>,
+    layout::field<&SubscribeResponse::quicr_namespace>,
+  };
+};
+
 MessageBuffer&
 operator<<(MessageBuffer& buffer, const SubscribeResponse& msg);
 MessageBuffer&
 operator>>(MessageBuffer& buffer, SubscribeResponse& msg);
+MessageBufferView&
+operator>>(MessageBufferView& buffer, SubscribeResponse& msg);
+DecodeStatus
+try_decode(MessageBufferView& buffer, SubscribeResponse& msg);
+size_t
+wire_size(const SubscribeResponse& msg);
 
 struct SubscribeEnd
 {
@@ -75,10 +139,26 @@ struct SubscribeEnd
   SubscribeResult::SubscribeStatus reason;
 };
 
+template<>
+struct MessageLayout<SubscribeEnd>
+{
+  static constexpr std::tuple fields{
+    layout::tag<MessageType::SubscribeEnd>,
+    layout::field_as<uint8_t, &SubscribeEnd::reason>,
+    layout::field<&SubscribeEnd::quicr_namespace>,
+  };
+};
+
 MessageBuffer&
 operator<<(MessageBuffer& buffer, const SubscribeEnd& msg);
 MessageBuffer&
 operator>>(MessageBuffer& buffer, SubscribeEnd& msg);
+MessageBufferView&
+operator>>(MessageBufferView& buffer, SubscribeEnd& msg);
+DecodeStatus
+try_decode(MessageBufferView& buffer, SubscribeEnd& msg);
+size_t
+wire_size(const SubscribeEnd& msg);
 
 /*===========================================================================*/
 // Publish Message Types
@@ -98,12 +178,31 @@ struct PublishIntent
   uintVar_t datagram_capable;
 };
 
+template<>
+struct MessageLayout<PublishIntent>
+{
+  static constexpr std::tuple fields{
+    layout::field<&PublishIntent::message_type>,
+    layout::field<&PublishIntent::transaction_id>,
+    layout::field<&PublishIntent::quicr_namespace>,
+    layout::field<&PublishIntent::payload>,
+    layout::field<&PublishIntent::media_id>,
+    layout::field<&PublishIntent::datagram_capable>,
+  };
+};
+
 MessageBuffer&
 operator<<(MessageBuffer& buffer, const PublishIntent& msg);
 MessageBuffer&
 operator<<(MessageBuffer& buffer, PublishIntent&& msg);
 MessageBuffer&
 operator>>(MessageBuffer& buffer, PublishIntent& msg);
+MessageBufferView&
+operator>>(MessageBufferView& buffer, PublishIntent& msg);
+DecodeStatus
+try_decode(MessageBufferView& buffer, PublishIntent& msg);
+size_t
+wire_size(const PublishIntent& msg);
 
 struct PublishIntentResponse
 {
@@ -116,10 +215,27 @@ struct PublishIntentResponse
   // *  [Reason Phrase (..)],
 };
 
+template<>
+struct MessageLayout<PublishIntentResponse>
+{
+  static constexpr std::tuple fields{
+    layout::field<&PublishIntentResponse::message_type>,
+    layout::field<&PublishIntentResponse::quicr_namespace>,
+    layout::field<&PublishIntentResponse::response>,
+    layout::field<&PublishIntentResponse::transaction_id>,
+  };
+};
+
 MessageBuffer&
 operator<<(MessageBuffer& buffer, const PublishIntentResponse& msg);
 MessageBuffer&
 operator>>(MessageBuffer& buffer, PublishIntentResponse& msg);
+MessageBufferView&
+operator>>(MessageBufferView& buffer, PublishIntentResponse& msg);
+DecodeStatus
+try_decode(MessageBufferView& buffer, PublishIntentResponse& msg);
+size_t
+wire_size(const PublishIntentResponse& msg);
 
 struct Header
 {
@@ -131,10 +247,29 @@ struct Header
   uint8_t flags;
 };
 
+template<>
+struct MessageLayout<Header>
+{
+  static constexpr std::tuple fields{
+    layout::field<&Header::name>,
+    layout::field<&Header::media_id>,
+    layout::field<&Header::group_id>,
+    layout::field<&Header::object_id>,
+    layout::field<&Header::offset_and_fin>,
+    layout::field<&Header::flags>,
+  };
+};
+
 MessageBuffer&
 operator<<(MessageBuffer& buffer, const Header& msg);
 MessageBuffer&
 operator>>(MessageBuffer& buffer, Header& msg);
+MessageBufferView&
+operator>>(MessageBufferView& buffer, Header& msg);
+DecodeStatus
+try_decode(MessageBufferView& buffer, Header& msg);
+size_t
+wire_size(const Header& msg);
 
 struct PublishDatagram
 {
@@ -144,12 +279,114 @@ struct PublishDatagram
   std::vector<uint8_t> media_data;
 };
 
+/**
+ * @brief Layout shared by the owning and viewing Publish datagrams.
+ */
+template<typename Datagram>
+struct PublishDatagramLayout
+{
+  static constexpr std::tuple fields{
+    layout::tag<MessageType::Publish>,
+    layout::field<&Datagram::header>,
+    layout::field<&Datagram::media_type>,
+    layout::field<&Datagram::media_data_length>,
+    layout::field<&Datagram::media_data>,
+  };
+
+  static DecodeStatus validate(const Datagram& msg)
+  {
+    return msg.media_data.size() == msg.media_data_length
+             ? DecodeStatus::Ok
+             : DecodeStatus::InvalidLength;
+  }
+};
+
+template<>
+struct MessageLayout<PublishDatagram> : PublishDatagramLayout<PublishDatagram>
+{
+};
+
 MessageBuffer&
 operator<<(MessageBuffer& buffer, const PublishDatagram& msg);
 MessageBuffer&
 operator<<(MessageBuffer& buffer, PublishDatagram&& msg);
 MessageBuffer&
 operator>>(MessageBuffer& buffer, PublishDatagram& msg);
+MessageBufferView&
+operator>>(MessageBufferView& buffer, PublishDatagram& msg);
+DecodeStatus
+try_decode(MessageBufferView& buffer, PublishDatagram& msg);
+size_t
+wire_size(const PublishDatagram& msg);
+
+/**
+ * @brief Publish datagram decoded in place from a received packet.
+ *
+ * @details media_data is a sub-span of the decoded bytes, so the packet must
+ *          outlive this struct. Used to inspect or forward an object without
+ *          copying its payload.
+ */
+struct PublishDatagramView
+{
+  Header header;
+  MediaType media_type;
+  uintVar_t media_data_length;
+  std::span<const uint8_t> media_data;
+};
+
+template<>
+struct MessageLayout<PublishDatagramView>
+  : PublishDatagramLayout<PublishDatagramView>
+{
+};
+
+MessageBufferView&
+operator>>(MessageBufferView& buffer, PublishDatagramView& msg);
+DecodeStatus
+try_decode(MessageBufferView& buffer, PublishDatagramView& msg);
+size_t
+wire_size(const PublishDatagramView& msg);
+
+/**
+ * @brief Reads the header of a Publish packet without decoding its payload.
+ *
+ * @details Only the message type and header are read, so a relay can route
+ *          or drop a packet by name before paying for a full decode. The
+ *          payload is neither copied nor validated.
+ *
+ * @throws MessageBuffer::MessageTypeException if the packet is not a Publish
+ * @throws MessageBuffer::ReadException if the header is truncated
+ */
+Header
+peek_publish_header(std::span<const uint8_t> packet);
+DecodeStatus
+try_peek_publish_header(std::span<const uint8_t> packet, Header& header);
+
+MessageBuffer&
+operator<<(MessageBuffer& buffer, const PublishDatagramView& msg);
+
+/**
+ * @brief Publish datagram encoded as header bytes and a payload span.
+ *
+ * @details The payload is not copied by encode_segments(); it refers to the
+ *          bytes of the encoded PublishDatagramView, which must outlive this
+ *          struct. gather() joins both into one packet with a single copy of
+ *          the payload, as the header buffer is reserved for the whole
+ *          datagram.
+ */
+struct PublishDatagramSegments
+{
+  MessageBuffer header;
+  std::span<const uint8_t> payload;
+
+  size_t size() const { return header.size() + payload.size(); }
+  std::vector<uint8_t> gather() &&;
+};
+
+PublishDatagramSegments
+encode_segments(const PublishDatagramView& msg);
+PublishDatagramSegments
+encode_segments(const PublishDatagramView& msg, BufferPool& pool);
 
 struct PublishStream
 {
@@ -157,12 +394,34 @@ struct PublishStream
   std::vector<uint8_t> media_data;
 };
 
+template<>
+struct MessageLayout<PublishStream>
+{
+  static constexpr std::tuple fields{
+    layout::field<&PublishStream::media_data_length>,
+    layout::field<&PublishStream::media_data>,
+  };
+
+  static DecodeStatus validate(const PublishStream& msg)
+  {
+    return msg.media_data.size() == msg.media_data_length
+             ? DecodeStatus::Ok
+             : DecodeStatus::InvalidLength;
+  }
+};
+
 MessageBuffer&
 operator<<(MessageBuffer& buffer, const PublishStream& msg);
 MessageBuffer&
 operator<<(MessageBuffer& buffer, PublishStream&& msg);
 MessageBuffer&
 operator>>(MessageBuffer& buffer, PublishStream& msg);
+MessageBufferView&
+operator>>(MessageBufferView& buffer, PublishStream& msg);
+DecodeStatus
+try_decode(MessageBufferView& buffer, PublishStream& msg);
+size_t
+wire_size(const PublishStream& msg);
 
 struct PublishIntentEnd
 {
@@ -173,21 +432,147 @@ struct PublishIntentEnd
   std::vector<uint8_t> payload;
 };
 
+template<>
+struct MessageLayout<PublishIntentEnd>
+{
+  static constexpr std::tuple fields{
+    layout::field<&PublishIntentEnd::message_type>,
+    layout::field<&PublishIntentEnd::quicr_namespace>,
+    layout::field<&PublishIntentEnd::payload>,
+  };
+};
+
 MessageBuffer&
 operator<<(MessageBuffer& buffer, const PublishIntentEnd& msg);
 MessageBuffer&
 operator<<(MessageBuffer& buffer, PublishIntentEnd&& msg);
 MessageBuffer&
 operator>>(MessageBuffer& buffer, PublishIntentEnd& msg);
+MessageBufferView&
+operator>>(MessageBufferView& buffer, PublishIntentEnd& msg);
+DecodeStatus
+try_decode(MessageBufferView& buffer, PublishIntentEnd& msg);
+size_t
+wire_size(const PublishIntentEnd& msg);
+
+/*===========================================================================*/
+// Batch Framing
+/*===========================================================================*/
+
+/**
+ * @brief Coalesces encoded messages into a single transport payload.
+ *
+ * @details A batch is MessageType::Batch and the total length of the
+ *          messages that follow, each as a length prefixed byte sequence:
+ *
+ *              type(8) length(i) [length(i) message(..)]...
+ *
+ *          The total length frames the batch like any other message, so
+ *          batches can be sent on reliable streams as well as datagrams.
+ *          Batches do not nest.
+ */
+class MessageBatch
+{
+public:
+  explicit MessageBatch(size_t max_size = MAX_TRANSPORT_DATA_SIZE);
+
+  bool empty() const { return _count == 0; }
+  size_t count() const { return _count; }
+
+  /**
+   * @brief Encoded size of the batch.
+   */
+  size_t size() const;
+
+  /**
+   * @brief Whether a message of message_size bytes can be appended without
+   *        the batch exceeding its max size.
+   */
+  bool fits(size_t message_size) const;
+  void append(std::span<const uint8_t> message);
+
+  /**
+   * @brief Returns the encoded batch, which is kept until clear().
+   */
+  std::vector<uint8_t> encode() const;
+  void clear();
+
+  /**
+   * @brief Returns the encoded batch and starts a new, empty one.
+   */
+  std::vector<uint8_t> flush();
+
+private:
+  // Messages appended so far, without the batch type and length
+  MessageBuffer _buffer;
+  size_t _max_size;
+  size_t _count{ 0 };
+};
+
+/**
+ * @brief Calls handler with a MessageBufferView of each message in an encoded
+ *        batch, in order.
+ *
+ * @details packet must hold exactly one batch.
+ *
+ * @returns DecodeStatus::Ok once every message has been handled, or the
+ *          failure that stopped the iteration.
+ */
+template<typename Handler>
+DecodeStatus
+for_each_batched(std::span<const uint8_t> packet, Handler&& handler)
+{
+  MessageBufferView batch{ packet };
+
+  uint8_t msg_type;
+  if (auto status = try_decode(batch, msg_type); status != DecodeStatus::Ok)
+    return status;
+  if (msg_type != static_cast<uint8_t>(MessageType::Batch))
+    return DecodeStatus::InvalidType;
+
+  std::span<const uint8_t> messages;
+  if (auto status = try_decode(batch, messages); status != DecodeStatus::Ok)
+    return status;
+  if (!batch.empty())
+    return DecodeStatus::InvalidLength;
+
+  batch = MessageBufferView{ messages };
+  while (!batch.empty()) {
+    std::span<const uint8_t> message;
+    if (auto status = try_decode(batch, message); status != DecodeStatus::Ok)
+      return status;
+
+    if (message.empty())
+      return DecodeStatus::InvalidLength;
+    if (message.front() == static_cast<uint8_t>(MessageType::Batch))
+      return DecodeStatus::InvalidType;
+
+    handler(MessageBufferView{ message });
+  }
+
+  return DecodeStatus::Ok;
+}
 
 MessageBuffer&
 operator<<(MessageBuffer& msg, const Name& ns);
 MessageBuffer&
 operator>>(MessageBuffer& msg, Name& ns);
+MessageBufferView&
+operator>>(MessageBufferView& msg, Name& ns);
+DecodeStatus
+try_decode(MessageBufferView& msg, Name& ns);
+size_t
+wire_size(const Name& ns);
 
 MessageBuffer&
 operator<<(MessageBuffer& msg, const Namespace& ns);
 MessageBuffer&
 operator>>(MessageBuffer& msg, Namespace& ns);
+MessageBufferView&
+operator>>(MessageBufferView& msg, Namespace& ns);
+DecodeStatus
+try_decode(MessageBufferView& msg, Namespace& ns);
+size_t
+wire_size(const Namespace& ns);
 
 }
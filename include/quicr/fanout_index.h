@@ -0,0 +1,115 @@
+#pragma once
+
+#include <quicr/namespace_matcher.h>
+#include <quicr/quicr_name.h>
+#include <quicr/quicr_namespace.h>
+#include <quicr/snapshot.h>
+
+#include <memory>
+#include <vector>
+
+namespace quicr {
+
+/**
+ * @brief Subscribers of type T per Namespace, for fanning out published
+ *        objects.
+ *
+ * @details The subscribers of each namespace are an immutable, reference
+ *          counted list, and the index of lists is itself an immutable
+ *          snapshot. Adding or removing a subscriber copies its namespace's
+ *          list, and the index, which shares every other list, then publishes
+ *          the new snapshot.
+ *
+ *          Readers load the index as a Snapshot, so fanning out an object
+ *          takes no lock and makes no allocation. Changes are serialised by
+ *          the snapshot's lock, and
+ *          cost O(namespaces), so suit subscriptions that change far less
+ *          often than objects are published.
+ *
+ *          Thread safe.
+ */
+template<typename T>
+class FanoutIndex
+{
+public:
+  using Subscribers = std::vector<T>;
+
+  /**
+   * @brief Adds subscriber to ns.
+   */
+  void add(const Namespace& ns, const T& subscriber)
+  {
+    const auto lock = _index.lock();
+    auto index = std::make_shared<Index>(_index.get());
+
+    auto& list = (*index)[ns];
+    auto subscribers = list ? std::make_shared<Subscribers>(*list)
+                            : std::make_shared<Subscribers>();
+    subscribers->push_back(subscriber);
+    list = std::move(subscribers);
+
+    _index.store(std::move(index));
+  }
+
+  /**
+   * @brief Removes the subscribers of ns for which pred returns true.
+   *
+   * @returns Number of subscribers removed.
+   */
+  template<typename Pred>
+  size_t erase_if(const Namespace& ns, Pred&& pred)
+  {
+    const auto lock = _index.lock();
+    const auto list = _index.get().find(ns);
+    if (!list)
+      return 0;
+
+    auto subscribers = std::make_shared<Subscribers>(**list);
+    const auto removed = std::erase_if(*subscribers, pred);
+    if (removed == 0)
+      return 0;
+
+    auto index = std::make_shared<Index>(_index.get());
+    if (subscribers->empty())
+      index->erase(ns);
+    else
+      (*index)[ns] = std::move(subscribers);
+
+    _index.store(std::move(index));
+    return removed;
+  }
+
+  /**
+   * @brief Snapshot of the subscribers of ns, or nullptr if it has none.
+   */
+  std::shared_ptr<const Subscribers> find(const Namespace& ns) const
+  {
+    const auto list = _index.load()->find(ns);
+    return list ? *list : nullptr;
+  }
+
+  /**
+   * @brief Calls func(const T&) for every subscriber of every namespace that
+   *        contains name.
+   *
+   * @details Iterates the snapshot current on entry, so func may itself read
+   *          or change this index, or others.
+   */
+  template<typename Func>
+  void for_each(const Name& name, Func&& func) const
+  {
+    // Held for the whole iteration, as func may reload the thread's cache
+    const auto index = _index.load();
+    index->for_each_match(name, [&](const Namespace&, const auto& list) {
+      for (const auto& subscriber : *list)
+        func(subscriber);
+    });
+  }
+
+private:
+  using Index = NamespaceMatcher<std::shared_ptr<const Subscribers>>;
+
+  Snapshot<Index> _index;
+};
+
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Hex kernels for fixed size values, as used by quicr::Name and HexEndec.
+ *
+ * Digits are written in upper case, most significant first, with no prefix
+ * or terminating null. Vectorised with AVX2 or SSE2 when the compiler targets
+ * them, with a scalar fallback otherwise.
+ */
+namespace quicr::hex {
+
+/**
+ * @brief Writes the 16 hex digits of value to out.
+ */
+void
+encode(uint64_t value, char* out);
+
+/**
+ * @brief Writes the 32 hex digits of the 128 bit value hi:low to out.
+ */
+void
+encode(uint64_t hi, uint64_t low, char* out);
+
+/**
+ * @brief Reads the 128 bit value hi:low from exactly 32 hex digits, in either
+ *        case.
+ *
+ * @returns false, leaving hi and low unspecified, if in holds any other
+ *          character.
+ */
+bool
+decode(const char* in, uint64_t& hi, uint64_t& low);
+
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <quicr/hex.h>
 #include <quicr/quicr_name.h>
 
 #include <algorithm>
@@ -9,6 +10,7 @@
 #include <cstdint>
 #include <iomanip>
 #include <span>
+#include <utility>
 #include <vector>
 
 namespace quicr {
@@ -39,6 +41,56 @@ class HexEndec
   {
   };
 
+  static constexpr std::array<uint8_t, sizeof...(Dist)> bit_distribution{
+    Dist...
+  };
+
+  // Offset of the least significant bit of each value, counted from the
+  // least significant bit of the Size bit string
+  static constexpr std::array<uint16_t, sizeof...(Dist)> bit_offsets = [] {
+    std::array<uint16_t, sizeof...(Dist)> out{};
+    uint16_t offset = Size;
+    for (size_t i = 0; i < sizeof...(Dist); ++i) {
+      offset -= std::min<uint16_t>(offset, bit_distribution[i]);
+      out[i] = offset;
+    }
+    return out;
+  }();
+
+  template<uint8_t Bits>
+  static constexpr uint64_t mask_bits(uint64_t value)
+  {
+    if constexpr (Bits >= sizeof(uint64_t) * 8)
+      return value;
+    else
+      return value & ~(~0x0ull << Bits);
+  }
+
+  template<uint16_t Offset, uint8_t Bits>
+  static constexpr void insert_bits(uint64_t& hi, uint64_t& low, uint64_t value)
+  {
+    value = mask_bits<Bits>(value);
+    if constexpr (Offset >= 64) {
+      hi |= value << (Offset - 64);
+    } else if constexpr (Offset == 0) {
+      low |= value;
+    } else {
+      low |= value << Offset;
+      hi |= value >> (64 - Offset);
+    }
+  }
+
+  template<uint16_t Offset, uint8_t Bits>
+  static constexpr uint64_t extract_bits(uint64_t hi, uint64_t low)
+  {
+    if constexpr (Offset >= 64)
+      return mask_bits<Bits>(hi >> (Offset - 64));
+    else if constexpr (Offset == 0)
+      return mask_bits<Bits>(low);
+    else
+      return mask_bits<Bits>((low >> Offset) | (hi << (64 - Offset)));
+  }
+
 public:
   HexEndec()
   {
@@ -112,7 +164,11 @@ public:
       bits |= (value & ~(~0x0ull << dist));
     };
 
-    return std::string("0x") + uint_to_hex<uint64_t>(bits);
+    std::string out_hex(2 + sizeof(uint64_t) * 2, '0');
+    out_hex[1] = 'x';
+    hex::encode(bits, out_hex.data() + 2);
+
+    return out_hex;
   }
 
   template<bool B = Size <= sizeof(uint64_t) * 8>
@@ -154,11 +210,14 @@ public:
     static const std::bitset<Size> bits_mask =
       (std::bitset<Size>().set() >> 64).flip();
     constexpr size_t sizeof_uint64_bits = sizeof(uint64_t) * 8;
+    constexpr size_t section_length = sizeof(uint64_t) * 2;
 
-    std::string out_hex = "0x";
+    std::string out_hex(2 + Size / 4, '0');
+    out_hex[1] = 'x';
     for (size_t i = 0; i < Size / sizeof_uint64_bits; ++i) {
-      out_hex += uint_to_hex<uint64_t>(
-        ((bits & bits_mask) >> (Size - sizeof_uint64_bits)).to_ullong());
+      hex::encode(
+        ((bits & bits_mask) >> (Size - sizeof_uint64_bits)).to_ullong(),
+        out_hex.data() + 2 + i * section_length);
       bits <<= sizeof_uint64_bits;
     }
 
@@ -183,6 +242,43 @@ public:
                   std::span<uint64_t>(values));
   }
 
+  /**
+   * @brief Encodes values according to Dist directly into a quicr::Name,
+   *        without going through a hex string.
+   *
+   * @details The Size bits are held in the least significant bits of the
+   *          name, as when the hex string from Encode is parsed as a name.
+   *          Shifts and masks are computed at compile time.
+   *
+   * @returns Name holding the provided values distributed according to Dist
+   *          in order.
+   */
+  template<typename... UInt_ts>
+  static constexpr quicr::Name EncodeName(UInt_ts... values)
+  {
+    static_assert(Size <= sizeof(quicr::Name) * 8,
+                  "Size cannot exceed the size of quicr::Name");
+    static_assert(Size == (Dist + ...),
+                  "Total bits cannot exceed specified size");
+    static_assert(sizeof...(Dist) == sizeof...(UInt_ts),
+                  "Number of values should match distribution of bits");
+    static_assert(is_valid_uint<UInt_ts...>::value,
+                  "Arguments must all be unsigned integers");
+
+    const std::array<uint64_t, sizeof...(UInt_ts)> vals{
+      static_cast<uint64_t>(values)...
+    };
+
+    uint64_t hi = 0;
+    uint64_t low = 0;
+    [&]<size_t... I>(std::index_sequence<I...>) {
+      (insert_bits<bit_offsets[I], bit_distribution[I]>(hi, low, vals[I]),
+       ...);
+    }(std::make_index_sequence<sizeof...(Dist)>{});
+
+    return { hi, low };
+  }
+
   /**
    * @brief Decodes a hex string that has size in bits of Size into a list of
    *        values sized according to Dist in order.
@@ -222,13 +318,47 @@ public:
     static_assert(Size >= (Dist + ...),
                   "Total bits cannot exceed specified size");
 
-    std::array<uint8_t, sizeof...(Dist)> distribution{ Dist... };
-    auto result = Decode(distribution, std::string_view(name.to_hex()));
-    std::array<Uint_t, sizeof...(Dist)> out;
-    std::copy_n(
-      std::make_move_iterator(result.begin()), sizeof...(Dist), out.begin());
+    if constexpr (Size <= sizeof(quicr::Name) * 8) {
+      return DecodeName<Uint_t>(name);
+    } else {
+      std::array<uint8_t, sizeof...(Dist)> distribution{ Dist... };
+      char hex[quicr::Name::hex_size];
+      auto result = Decode(distribution, name.to_hex(hex));
+      std::array<Uint_t, sizeof...(Dist)> out;
+      std::copy_n(
+        std::make_move_iterator(result.begin()), sizeof...(Dist), out.begin());
+
+      return out;
+    }
+  }
 
-    return out;
+  /**
+   * @brief Decodes the values distributed according to Dist directly from a
+   *        quicr::Name, without going through a hex string.
+   *
+   * @details The inverse of EncodeName. Shifts and masks are computed at
+   *          compile time.
+   *
+   * @returns Values decoded from the name corresponding in order to the size
+   *          of Dist.
+   */
+  template<
+    typename Uint_t = uint64_t,
+    typename = typename std::enable_if<is_valid_uint<Uint_t>::value, Uint_t>>
+  static constexpr std::array<Uint_t, sizeof...(Dist)> DecodeName(
+    const quicr::Name& name)
+  {
+    static_assert(Size <= sizeof(quicr::Name) * 8,
+                  "Size cannot exceed the size of quicr::Name");
+    static_assert(Size >= (Dist + ...),
+                  "Total bits cannot exceed specified size");
+
+    const uint64_t hi = name.hi();
+    const uint64_t low = name.low();
+    return [&]<size_t... I>(std::index_sequence<I...>) {
+      return std::array<Uint_t, sizeof...(Dist)>{ static_cast<Uint_t>(
+        extract_bits<bit_offsets[I], bit_distribution[I]>(hi, low))... };
+    }(std::make_index_sequence<sizeof...(Dist)>{});
   }
 
   template<
@@ -277,11 +407,18 @@ public:
     constexpr uint8_t section_length = sizeof(uint64_t) * 2;
     constexpr size_t sizeof_uint64_bits = section_length * 4;
     constexpr size_t num_sections = Size / sizeof_uint64_bits;
-    for (size_t i = 0, j = 0; i < (section_length * num_sections);
-         i += section_length) {
-      bits |=
-        std::bitset<Size>(hex_to_uint<uint64_t>(hex.substr(i, section_length)))
-        << (sizeof_uint64_bits * (num_sections - ++j));
+
+    uint64_t hi, low;
+    if (num_sections == 2 && hex::decode(hex.data(), hi, low)) {
+      bits = (std::bitset<Size>(hi) << sizeof_uint64_bits) |
+             std::bitset<Size>(low);
+    } else {
+      for (size_t i = 0, j = 0; i < (section_length * num_sections);
+           i += section_length) {
+        bits |= std::bitset<Size>(
+                  hex_to_uint<uint64_t>(hex.substr(i, section_length)))
+                << (sizeof_uint64_bits * (num_sections - ++j));
+      }
     }
 
     const auto dist_size = distribution.size();
@@ -299,7 +436,8 @@ public:
   static inline std::vector<Uint_t> Decode(std::span<uint8_t> distribution,
                                            const quicr::Name& name)
   {
-    return Decode(distribution, std::string_view(name.to_hex()));
+    char hex[quicr::Name::hex_size];
+    return Decode(distribution, name.to_hex(hex));
   }
 };
 }
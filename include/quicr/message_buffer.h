@@ -1,60 +1,27 @@
 #pragma once
 
+#include <quicr/varint.h>
+
 #include <cassert>
+#include <cstdint>
 #include <ostream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
 #include <vector>
 
-namespace quicr {
-/**
- * @brief Variable length integer
- */
-class uintVar_t
-{
-public:
-  uintVar_t() = default;
-  constexpr uintVar_t(const uintVar_t&) = default;
-  constexpr uintVar_t(uintVar_t&&) = default;
-  constexpr uintVar_t(uint64_t value)
-    : _value{ value }
-  {
-    if (value >= 0x1ull << 61)
-      throw std::runtime_error("Max value cannot be exceeded: " +
-                               std::to_string(0x1ull << 61));
-  }
-
-  constexpr operator uint64_t() const { return _value; }
-  constexpr uintVar_t& operator=(const uintVar_t&) = default;
-  constexpr uintVar_t& operator=(uintVar_t&&) = default;
-  constexpr uintVar_t& operator=(uint64_t value)
-  {
-    if (value >= 0x1ull << 61)
-      throw std::runtime_error("Max value cannot be exceeded: " +
-                               std::to_string(0x1ull << 61));
-    _value = value;
-    return *this;
-  }
-
-  constexpr bool operator==(uintVar_t other) { return _value == other._value; }
-  constexpr bool operator!=(uintVar_t other) { return !(*this == other); }
-  constexpr bool operator>(uintVar_t other) { return _value > other._value; }
-  constexpr bool operator>=(uintVar_t other) { return _value >= other._value; }
-  constexpr bool operator<(uintVar_t other) { return _value < other._value; }
-  constexpr bool operator<=(uintVar_t other) { return _value <= other._value; }
-
-  friend std::ostream& operator<<(std::ostream& os, uintVar_t v)
-  {
-    return os << v._value;
-  }
-
-private:
-  uint64_t _value;
-};
-}
-
 namespace quicr::messages {
 
+class BufferPool;
+class MessageBufferView;
+
 /**
  * @brief Defines a buffer that can be sent over transport. Cannot be copied.
+ *
+ * @details Bytes are written to the back of the buffer and read from a read
+ *          offset at the front. Reading only advances the offset, so decoding
+ *          a message never moves the bytes that remain in the buffer.
  */
 class MessageBuffer
 {
@@ -81,39 +48,71 @@ public:
 
 public:
   MessageBuffer() = default;
-  MessageBuffer(const MessageBuffer& other) = default;
-  MessageBuffer(MessageBuffer&& other) = default;
+  MessageBuffer(const MessageBuffer& other);
+  MessageBuffer(MessageBuffer&& other);
   MessageBuffer(size_t reserve_size) { _buffer.reserve(reserve_size); }
   MessageBuffer(const std::vector<uint8_t>& buffer);
   MessageBuffer(std::vector<uint8_t>&& buffer);
-  ~MessageBuffer() = default;
 
-  bool empty() const { return _buffer.empty(); }
+  /**
+   * @brief Draws the storage from pool. Unless it is moved out with get(),
+   *        the storage is returned to pool when the buffer is destroyed.
+   */
+  MessageBuffer(size_t reserve_size, BufferPool& pool);
+  ~MessageBuffer();
+
+  bool empty() const { return _read_offset == _buffer.size(); }
+  size_t size() const { return _buffer.size() - _read_offset; }
 
   void push(uint8_t t) { _buffer.push_back(t); }
   void pop();
-  const uint8_t& front() const { return _buffer.front(); }
+  const uint8_t& front() const { return _buffer[_read_offset]; }
 
   void push(const std::vector<uint8_t>& data);
+  void push(std::span<const uint8_t> data);
   void push(std::vector<uint8_t>&& data);
-  void pop(uint16_t len);
-  std::vector<uint8_t> front(uint16_t len);
-  std::vector<uint8_t> pop_front(uint16_t len);
+  void pop(size_t len);
+  std::vector<uint8_t> front(size_t len);
+  std::vector<uint8_t> pop_front(size_t len);
+
+  /**
+   * @brief Grows the buffer by len bytes, to be written in place. The span is
+   *        invalidated by any later write to this buffer.
+   */
+  std::span<uint8_t> extend(size_t len)
+  {
+    const auto offset = _buffer.size();
+    _buffer.resize(offset + len);
+    return { _buffer.data() + offset, len };
+  }
 
   std::vector<uint8_t> get();
 
+  /**
+   * @brief Read-only view over the bytes that have not been read yet. The view
+   *        is invalidated by any write to this buffer.
+   */
+  MessageBufferView view() const;
+
   std::string to_hex() const;
 
-  MessageBuffer& operator=(const MessageBuffer& other) = default;
-  MessageBuffer& operator=(MessageBuffer&& other) = default;
+  MessageBuffer& operator=(const MessageBuffer& other);
+  MessageBuffer& operator=(MessageBuffer&& other);
 
   template<typename Uint_t>
   friend MessageBuffer& operator<<(MessageBuffer& msg, Uint_t val);
   template<typename Uint_t>
   friend MessageBuffer& operator>>(MessageBuffer& msg, Uint_t& val);
+  friend MessageBuffer& operator<<(MessageBuffer& msg,
+                                   std::span<const uintVar_t> values);
 
 private:
+  const uint8_t* read_ptr() const { return _buffer.data() + _read_offset; }
+  void consume(size_t len);
+
   std::vector<uint8_t> _buffer;
+  size_t _read_offset{ 0 };
+  BufferPool* _pool{ nullptr };
 };
 
 MessageBuffer&
@@ -121,6 +120,12 @@ operator<<(MessageBuffer& msg, const uintVar_t& val);
 MessageBuffer&
 operator>>(MessageBuffer& msg, uintVar_t& val);
 
+/**
+ * @brief Encodes values back to back, with a single resize of the buffer.
+ */
+MessageBuffer&
+operator<<(MessageBuffer& msg, std::span<const uintVar_t> values);
+
 MessageBuffer&
 operator<<(MessageBuffer& msg, const std::vector<uint8_t>& val);
 MessageBuffer&
@@ -128,4 +133,115 @@ operator<<(MessageBuffer& msg, std::vector<uint8_t>&& val);
 MessageBuffer&
 operator>>(MessageBuffer& msg, std::vector<uint8_t>& val);
 
+/**
+ * @brief Read-only view over an encoded message, typically a packet received
+ *        from the transport.
+ *
+ * @details Decodes the same wire format as MessageBuffer without owning or
+ *          copying the viewed bytes; reading only narrows the view. Byte
+ *          sequences can be read as sub-spans of the viewed bytes, which must
+ *          therefore outlive the view and anything read from it.
+ */
+class MessageBufferView
+{
+public:
+  MessageBufferView() = default;
+  MessageBufferView(const MessageBufferView& other) = default;
+  MessageBufferView(std::span<const uint8_t> data)
+    : _data{ data }
+  {
+  }
+  ~MessageBufferView() = default;
+
+  bool empty() const { return _data.empty(); }
+  size_t size() const { return _data.size(); }
+
+  void pop();
+  const uint8_t& front() const { return _data.front(); }
+
+  void pop(size_t len);
+  std::span<const uint8_t> front(size_t len) const;
+  std::span<const uint8_t> pop_front(size_t len);
+
+  std::span<const uint8_t> data() const { return _data; }
+
+  MessageBufferView& operator=(const MessageBufferView& other) = default;
+
+private:
+  std::span<const uint8_t> _data;
+};
+
+/**
+ * @brief Result of a non-throwing decode.
+ */
+enum class DecodeStatus : uint8_t
+{
+  Ok = 0,
+  Truncated,     // The buffer ended before the value did
+  InvalidType,   // The message type does not match the decoded message
+  InvalidLength, // An encoded length disagrees with the decoded data
+};
+
+/**
+ * @brief Throws the MessageBuffer exception that matches a failed decode of
+ *        the named type. Does nothing for DecodeStatus::Ok.
+ */
+void
+throw_on_error(DecodeStatus status, std::string_view type_name);
+
+/*
+ * try_decode() reads a value from the view without throwing, for use on
+ * receive paths where malformed packets are expected. On failure the view
+ * and the value are left in an unspecified state. The operator>> overloads
+ * decode the same way, but throw on failure.
+ */
+
+template<typename Uint_t>
+DecodeStatus
+try_decode(MessageBufferView& msg, Uint_t& val);
+
+DecodeStatus
+try_decode(MessageBufferView& msg, uintVar_t& val);
+DecodeStatus
+try_decode(MessageBufferView& msg, std::vector<uint8_t>& val);
+DecodeStatus
+try_decode(MessageBufferView& msg, std::span<const uint8_t>& val);
+
+/**
+ * @brief Decodes fields in order, stopping at the first failure.
+ */
+template<typename... Fields>
+DecodeStatus
+try_decode_fields(MessageBufferView& msg, Fields&... fields)
+{
+  auto status = DecodeStatus::Ok;
+  (((status = try_decode(msg, fields)) == DecodeStatus::Ok) && ...);
+  return status;
+}
+
+template<typename Uint_t>
+MessageBufferView&
+operator>>(MessageBufferView& msg, Uint_t& val);
+
+MessageBufferView&
+operator>>(MessageBufferView& msg, uintVar_t& val);
+MessageBufferView&
+operator>>(MessageBufferView& msg, std::vector<uint8_t>& val);
+MessageBufferView&
+operator>>(MessageBufferView& msg, std::span<const uint8_t>& val);
+
+/**
+ * @brief Decodes val from the unread bytes of msg through a view, consuming
+ *        only the bytes that were read.
+ */
+template<typename T>
+MessageBuffer&
+read_from_view(MessageBuffer& msg, T& val)
+{
+  auto view = msg.view();
+  view >> val;
+  msg.pop(msg.size() - view.size());
+  return msg;
+}
+
 }
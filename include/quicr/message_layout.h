@@ -0,0 +1,461 @@
+#pragma once
+
+#include <quicr/message_buffer.h>
+#include <quicr/quicr_common.h>
+#include <quicr/quicr_name.h>
+#include <quicr/quicr_namespace.h>
+#include <quicr/varint.h>
+
+#include <cstring>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace quicr::messages {
+
+/**
+ * @brief Describes the wire layout of a message as a tuple of fields, in wire
+ *        order:
+ *
+ *          template<>
+ *          struct MessageLayout<Unsubscribe>
+ *          {
+ *            static constexpr std::tuple fields{
+ *              layout::tag<MessageType::Unsubscribe>,
+ *              layout::field<&Unsubscribe::quicr_namespace>,
+ *            };
+ *          };
+ *
+ *        A layout may also define a static validate(const T&) returning a
+ *        DecodeStatus, which is checked once the fields are decoded.
+ *
+ * @details The functions in quicr::messages::layout generate the encoder,
+ *          decoder and wire size of a described message. Everything is
+ *          inline, so a whole message is encoded with a single resize of the
+ *          buffer and decoded with one cursor, letting the compiler fuse the
+ *          stores and bounds checks of consecutive fields.
+ */
+template<typename T>
+struct MessageLayout;
+
+namespace layout {
+
+/**
+ * @brief Field stored in member Member, encoded as its own type.
+ */
+template<auto Member>
+struct Field
+{
+};
+
+/**
+ * @brief Field stored in member Member, encoded as Wire. Used for enums whose
+ *        underlying type is wider than their wire form.
+ */
+template<typename Wire, auto Member>
+struct FieldAs
+{
+};
+
+/**
+ * @brief Constant message type byte, which must match on decode.
+ */
+template<MessageType Type>
+struct Tag
+{
+};
+
+template<auto Member>
+inline constexpr Field<Member> field{};
+
+template<typename Wire, auto Member>
+inline constexpr FieldAs<Wire, Member> field_as{};
+
+template<MessageType Type>
+inline constexpr Tag<Type> tag{};
+
+template<typename T>
+concept Described = requires { MessageLayout<T>::fields; };
+
+/**
+ * @brief Read position within a decoded message.
+ */
+struct Reader
+{
+  const uint8_t* pos;
+  const uint8_t* end;
+
+  size_t remaining() const { return static_cast<size_t>(end - pos); }
+};
+
+/*===========================================================================*/
+// Value codecs
+/*===========================================================================*/
+
+template<typename T>
+struct Codec;
+
+template<typename Uint_t>
+  requires std::is_unsigned_v<Uint_t>
+struct Codec<Uint_t>
+{
+  static constexpr size_t size(const Uint_t&) { return sizeof(Uint_t); }
+
+  static uint8_t* write(uint8_t* out, Uint_t value)
+  {
+    if constexpr (sizeof(Uint_t) > 1)
+      value = swap_bytes(value);
+    std::memcpy(out, &value, sizeof(Uint_t));
+    return out + sizeof(Uint_t);
+  }
+
+  static DecodeStatus read(Reader& in, Uint_t& value)
+  {
+    if (in.remaining() < sizeof(Uint_t))
+      return DecodeStatus::Truncated;
+
+    std::memcpy(&value, in.pos, sizeof(Uint_t));
+    if constexpr (sizeof(Uint_t) > 1)
+      value = swap_bytes(value);
+    in.pos += sizeof(Uint_t);
+    return DecodeStatus::Ok;
+  }
+};
+
+template<typename Enum_t>
+  requires std::is_enum_v<Enum_t>
+struct Codec<Enum_t>
+{
+  using Wire = std::underlying_type_t<Enum_t>;
+
+  static constexpr size_t size(const Enum_t&) { return sizeof(Wire); }
+
+  static uint8_t* write(uint8_t* out, Enum_t value)
+  {
+    return Codec<Wire>::write(out, static_cast<Wire>(value));
+  }
+
+  static DecodeStatus read(Reader& in, Enum_t& value)
+  {
+    Wire wire{};
+    const auto status = Codec<Wire>::read(in, wire);
+    value = static_cast<Enum_t>(wire);
+    return status;
+  }
+};
+
+template<>
+struct Codec<uintVar_t>
+{
+  static constexpr size_t size(const uintVar_t& value)
+  {
+    return varint::size(value);
+  }
+
+  static uint8_t* write(uint8_t* out, const uintVar_t& value)
+  {
+    return out + varint::encode(value, out);
+  }
+
+  static DecodeStatus read(Reader& in, uintVar_t& value)
+  {
+    if (in.remaining() == 0)
+      return DecodeStatus::Truncated;
+
+    const auto length = varint::length(*in.pos);
+    if (in.remaining() < length)
+      return DecodeStatus::Truncated;
+
+    value = varint::decode(in.pos, length);
+    in.pos += length;
+    return DecodeStatus::Ok;
+  }
+};
+
+/**
+ * @brief Length prefixed byte sequence. Decoding into a span refers to the
+ *        decoded bytes instead of copying them.
+ */
+template<typename Bytes>
+struct BytesCodec
+{
+  static constexpr size_t size(const Bytes& value)
+  {
+    return varint::size(value.size()) + value.size();
+  }
+
+  static uint8_t* write(uint8_t* out, const Bytes& value)
+  {
+    out += varint::encode(value.size(), out);
+    if (!value.empty())
+      std::memcpy(out, value.data(), value.size());
+    return out + value.size();
+  }
+
+  static DecodeStatus read(Reader& in, Bytes& value)
+  {
+    uintVar_t length;
+    if (auto status = Codec<uintVar_t>::read(in, length);
+        status != DecodeStatus::Ok)
+      return status;
+
+    if (in.remaining() < length)
+      return DecodeStatus::Truncated;
+
+    value = Bytes(in.pos, in.pos + static_cast<size_t>(length));
+    in.pos += length;
+    return DecodeStatus::Ok;
+  }
+};
+
+template<>
+struct Codec<std::vector<uint8_t>> : BytesCodec<std::vector<uint8_t>>
+{
+};
+
+template<>
+struct Codec<std::span<const uint8_t>> : BytesCodec<std::span<const uint8_t>>
+{
+};
+
+/**
+ * @brief Names are sent as a 128 bit big-endian value.
+ */
+template<>
+struct Codec<Name>
+{
+  static constexpr size_t size(const Name&) { return sizeof(Name); }
+
+  static uint8_t* write(uint8_t* out, const Name& value)
+  {
+    out = Codec<uint64_t>::write(out, value.hi());
+    return Codec<uint64_t>::write(out, value.low());
+  }
+
+  static DecodeStatus read(Reader& in, Name& value)
+  {
+    if (in.remaining() < sizeof(Name))
+      return DecodeStatus::Truncated;
+
+    uint64_t hi = 0;
+    uint64_t low = 0;
+    Codec<uint64_t>::read(in, hi);
+    Codec<uint64_t>::read(in, low);
+    value = Name{ hi, low };
+    return DecodeStatus::Ok;
+  }
+};
+
+template<>
+struct Codec<Namespace>
+{
+  static constexpr size_t size(const Namespace&)
+  {
+    return sizeof(Name) + sizeof(uint8_t);
+  }
+
+  static uint8_t* write(uint8_t* out, const Namespace& value)
+  {
+    out = Codec<Name>::write(out, value.name());
+    return Codec<uint8_t>::write(out, value.length());
+  }
+
+  static DecodeStatus read(Reader& in, Namespace& value)
+  {
+    if (in.remaining() < size(value))
+      return DecodeStatus::Truncated;
+
+    Name name;
+    uint8_t length = 0;
+    Codec<Name>::read(in, name);
+    Codec<uint8_t>::read(in, length);
+    value = Namespace{ name, length };
+    return DecodeStatus::Ok;
+  }
+};
+
+template<Described T>
+constexpr size_t
+wire_size(const T& msg);
+template<Described T>
+uint8_t*
+write(uint8_t* out, const T& msg);
+template<Described T>
+DecodeStatus
+read(Reader& in, T& msg);
+
+/**
+ * @brief Nested described structs, such as a Header within a datagram, are
+ *        encoded in place as fields.
+ */
+template<Described T>
+struct Codec<T>
+{
+  static constexpr size_t size(const T& value)
+  {
+    return layout::wire_size(value);
+  }
+
+  static uint8_t* write(uint8_t* out, const T& value)
+  {
+    return layout::write(out, value);
+  }
+
+  static DecodeStatus read(Reader& in, T& value)
+  {
+    return layout::read(in, value);
+  }
+};
+
+/*===========================================================================*/
+// Field descriptors
+/*===========================================================================*/
+
+template<typename T, typename Descriptor>
+struct FieldCodec;
+
+template<typename T, typename Class, typename Member, Member Class::*Ptr>
+struct FieldCodec<T, Field<Ptr>>
+{
+  static constexpr size_t size(const T& msg)
+  {
+    return Codec<Member>::size(msg.*Ptr);
+  }
+
+  static uint8_t* write(uint8_t* out, const T& msg)
+  {
+    return Codec<Member>::write(out, msg.*Ptr);
+  }
+
+  static DecodeStatus read(Reader& in, T& msg)
+  {
+    return Codec<Member>::read(in, msg.*Ptr);
+  }
+};
+
+template<typename T,
+         typename Wire,
+         typename Class,
+         typename Member,
+         Member Class::*Ptr>
+struct FieldCodec<T, FieldAs<Wire, Ptr>>
+{
+  static constexpr size_t size(const T&) { return sizeof(Wire); }
+
+  static uint8_t* write(uint8_t* out, const T& msg)
+  {
+    return Codec<Wire>::write(out, static_cast<Wire>(msg.*Ptr));
+  }
+
+  static DecodeStatus read(Reader& in, T& msg)
+  {
+    Wire wire{};
+    const auto status = Codec<Wire>::read(in, wire);
+    msg.*Ptr = static_cast<Member>(wire);
+    return status;
+  }
+};
+
+template<typename T, MessageType Type>
+struct FieldCodec<T, Tag<Type>>
+{
+  static constexpr size_t size(const T&) { return sizeof(MessageType); }
+
+  static uint8_t* write(uint8_t* out, const T&)
+  {
+    return Codec<MessageType>::write(out, Type);
+  }
+
+  static DecodeStatus read(Reader& in, T&)
+  {
+    MessageType type;
+    if (auto status = Codec<MessageType>::read(in, type);
+        status != DecodeStatus::Ok)
+      return status;
+
+    return type == Type ? DecodeStatus::Ok : DecodeStatus::InvalidType;
+  }
+};
+
+/*===========================================================================*/
+// Generated encode, decode and wire size
+/*===========================================================================*/
+
+template<Described T>
+constexpr size_t
+wire_size(const T& msg)
+{
+  return std::apply(
+    [&msg](const auto&... fields) {
+      return (FieldCodec<T, std::decay_t<decltype(fields)>>::size(msg) + ... +
+              size_t(0));
+    },
+    MessageLayout<T>::fields);
+}
+
+template<Described T>
+uint8_t*
+write(uint8_t* out, const T& msg)
+{
+  std::apply(
+    [&](const auto&... fields) {
+      ((out = FieldCodec<T, std::decay_t<decltype(fields)>>::write(out, msg)),
+       ...);
+    },
+    MessageLayout<T>::fields);
+  return out;
+}
+
+template<Described T>
+DecodeStatus
+read(Reader& in, T& msg)
+{
+  auto status = DecodeStatus::Ok;
+  std::apply(
+    [&](const auto&... fields) {
+      (((status = FieldCodec<T, std::decay_t<decltype(fields)>>::read(
+           in, msg)) == DecodeStatus::Ok) &&
+       ...);
+    },
+    MessageLayout<T>::fields);
+
+  if constexpr (requires { MessageLayout<T>::validate(msg); }) {
+    if (status == DecodeStatus::Ok)
+      status = MessageLayout<T>::validate(msg);
+  }
+
+  return status;
+}
+
+/**
+ * @brief Appends value to buffer, growing the buffer once.
+ */
+template<typename T>
+MessageBuffer&
+encode(MessageBuffer& buffer, const T& value)
+{
+  Codec<T>::write(buffer.extend(Codec<T>::size(value)).data(), value);
+  return buffer;
+}
+
+/**
+ * @brief Decodes value from the front of buffer, consuming only the bytes
+ *        read.
+ */
+template<typename T>
+DecodeStatus
+decode(MessageBufferView& buffer, T& value)
+{
+  const auto data = buffer.data();
+  Reader in{ data.data(), data.data() + data.size() };
+
+  const auto status = Codec<T>::read(in, value);
+  buffer.pop(static_cast<size_t>(in.pos - data.data()));
+
+  return status;
+}
+
+} // namespace layout
+
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace quicr {
+
+/**
+ * @brief Bounded lock-free multi-producer multi-consumer queue.
+ *
+ * @details Each cell carries a sequence number that tells producers and
+ *          consumers whose turn it is, so push and pop only contend on a
+ *          single compare-exchange of their position. Capacity is rounded up
+ *          to a power of two. Based on Dmitry Vyukov's bounded MPMC queue.
+ */
+template<typename T>
+class MPMCQueue
+{
+public:
+  explicit MPMCQueue(size_t capacity)
+    : _mask{ std::bit_ceil(std::max<size_t>(capacity, 2)) - 1 }
+    , _cells{ std::make_unique<Cell[]>(_mask + 1) }
+  {
+    for (size_t i = 0; i <= _mask; ++i) {
+      _cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  MPMCQueue(const MPMCQueue&) = delete;
+  MPMCQueue& operator=(const MPMCQueue&) = delete;
+
+  size_t capacity() const { return _mask + 1; }
+
+  /**
+   * @brief Pushes value unless the queue is full. value is left untouched
+   *        when false is returned.
+   */
+  bool try_push(T&& value)
+  {
+    auto pos = _enqueue_pos.load(std::memory_order_relaxed);
+    Cell* cell;
+
+    while (true) {
+      cell = &_cells[pos & _mask];
+      const auto seq = cell->sequence.load(std::memory_order_acquire);
+      const auto diff = static_cast<std::ptrdiff_t>(seq - pos);
+
+      if (diff == 0) {
+        if (_enqueue_pos.compare_exchange_weak(
+              pos, pos + 1, std::memory_order_relaxed))
+          break;
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = _enqueue_pos.load(std::memory_order_relaxed);
+      }
+    }
+
+    cell->value = std::move(value);
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Pops the oldest value into value unless the queue is empty.
+   */
+  bool try_pop(T& value)
+  {
+    auto pos = _dequeue_pos.load(std::memory_order_relaxed);
+    Cell* cell;
+
+    while (true) {
+      cell = &_cells[pos & _mask];
+      const auto seq = cell->sequence.load(std::memory_order_acquire);
+      const auto diff = static_cast<std::ptrdiff_t>(seq - (pos + 1));
+
+      if (diff == 0) {
+        if (_dequeue_pos.compare_exchange_weak(
+              pos, pos + 1, std::memory_order_relaxed))
+          break;
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = _dequeue_pos.load(std::memory_order_relaxed);
+      }
+    }
+
+    value = std::move(cell->value);
+    cell->sequence.store(pos + _mask + 1, std::memory_order_release);
+    return true;
+  }
+
+private:
+  static constexpr size_t cache_line_size = 64;
+
+  struct Cell
+  {
+    std::atomic<size_t> sequence;
+    T value;
+  };
+
+  const size_t _mask;
+  std::unique_ptr<Cell[]> _cells;
+
+  alignas(cache_line_size) std::atomic<size_t> _enqueue_pos{ 0 };
+  alignas(cache_line_size) std::atomic<size_t> _dequeue_pos{ 0 };
+};
+
+}
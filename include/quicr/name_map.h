@@ -0,0 +1,170 @@
+#pragma once
+
+#include <quicr/quicr_name.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace quicr {
+
+/**
+ * @brief Map of Name to T, as an open addressing hash table.
+ *
+ * @details Entries are held inline in one flat array and found by linear
+ *          probing from the hash of the name, so a lookup is one hash and,
+ *          at the load factors kept here, usually one cache line. Erasing
+ *          shifts the following entries of the probe run back rather than
+ *          leaving tombstones, so lookups stay short under churn.
+ *
+ *          Pointers to values are invalidated by inserting into the map, and
+ *          by erasing from it.
+ *
+ *          Not thread safe.
+ */
+template<typename T>
+class NameMap
+{
+public:
+  /**
+   * @brief Value of name, default constructed if name is not in the map.
+   */
+  T& operator[](const Name& name) { return *try_emplace(name).first; }
+
+  /**
+   * @brief Inserts name with a value constructed from args, unless name is
+   *        already in the map.
+   *
+   * @returns Value of name, and whether it was inserted.
+   */
+  template<typename... Args>
+  std::pair<T*, bool> try_emplace(const Name& name, Args&&... args)
+  {
+    if (T* value = find(name))
+      return { value, false };
+
+    if ((_size + 1) * 8 > _slots.size() * 7)
+      rehash(std::max<size_t>(min_capacity, _slots.size() * 2));
+
+    auto& slot = _slots[probe(name)];
+    slot.name = name;
+    slot.value = T(std::forward<Args>(args)...);
+    slot.occupied = true;
+    ++_size;
+
+    return { &slot.value, true };
+  }
+
+  /**
+   * @brief Value of name, or nullptr if name is not in the map.
+   */
+  T* find(const Name& name)
+  {
+    if (_size == 0)
+      return nullptr;
+
+    auto& slot = _slots[probe(name)];
+    return slot.occupied ? &slot.value : nullptr;
+  }
+
+  const T* find(const Name& name) const
+  {
+    return const_cast<NameMap*>(this)->find(name);
+  }
+
+  bool contains(const Name& name) const { return find(name) != nullptr; }
+
+  /**
+   * @brief Removes name, and its value, from the map.
+   *
+   * @returns Whether name was in the map.
+   */
+  bool erase(const Name& name)
+  {
+    if (_size == 0)
+      return false;
+
+    auto hole = probe(name);
+    if (!_slots[hole].occupied)
+      return false;
+
+    // Move back every later entry of the run that may sit at the hole
+    const auto mask = _slots.size() - 1;
+    for (auto index = (hole + 1) & mask; _slots[index].occupied;
+         index = (index + 1) & mask) {
+      const auto home = slot_index(_slots[index].name);
+      if (((index - home) & mask) >= ((index - hole) & mask)) {
+        _slots[hole] = std::move(_slots[index]);
+        hole = index;
+      }
+    }
+
+    _slots[hole].occupied = false;
+    _slots[hole].value = T();
+    --_size;
+    return true;
+  }
+
+  /**
+   * @brief Calls func(const Name&, T&) for every entry, in no particular order.
+   */
+  template<typename Func>
+  void for_each(Func&& func)
+  {
+    for (auto& slot : _slots) {
+      if (slot.occupied)
+        func(std::as_const(slot.name), slot.value);
+    }
+  }
+
+  size_t size() const { return _size; }
+  bool empty() const { return _size == 0; }
+
+  void clear()
+  {
+    _slots.clear();
+    _size = 0;
+  }
+
+private:
+  static constexpr size_t min_capacity = 16;
+
+  struct Slot
+  {
+    Name name{ uint64_t{ 0 }, uint64_t{ 0 } };
+    T value{};
+    bool occupied{ false };
+  };
+
+  size_t slot_index(const Name& name) const
+  {
+    return std::hash<Name>{}(name) & (_slots.size() - 1);
+  }
+
+  // Slot holding name, or the free slot ending its probe run
+  size_t probe(const Name& name) const
+  {
+    const auto mask = _slots.size() - 1;
+    auto index = slot_index(name);
+    while (_slots[index].occupied && _slots[index].name != name)
+      index = (index + 1) & mask;
+
+    return index;
+  }
+
+  void rehash(size_t capacity)
+  {
+    auto slots = std::exchange(_slots, std::vector<Slot>(capacity));
+    for (auto& slot : slots) {
+      if (slot.occupied)
+        _slots[probe(slot.name)] = std::move(slot);
+    }
+  }
+
+  std::vector<Slot> _slots;
+  size_t _size{ 0 };
+};
+
+}
@@ -0,0 +1,159 @@
+#pragma once
+
+#include <quicr/quicr_name.h>
+#include <quicr/quicr_namespace.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+
+namespace quicr {
+
+/**
+ * @brief Map of Namespace to T, indexed by prefix length.
+ *
+ * @details Holds one hash table per prefix length, keyed by the masked name,
+ *          and a bitmap of the lengths that have any namespaces. Finding every
+ *          namespace that contains a name probes only the populated lengths,
+ *          which are usually few, with one hash lookup each.
+ *
+ *          Has the same interface as NamespaceTrie, which suits sets with
+ *          many distinct prefix lengths better.
+ *
+ *          Not thread safe.
+ */
+template<typename T>
+class NamespaceMatcher
+{
+public:
+  /**
+   * @brief Value of ns, default constructed if ns is not in the matcher.
+   */
+  T& operator[](const Namespace& ns)
+  {
+    const auto length = canonical_length(ns);
+    auto& table = _tables[length];
+    auto [it, inserted] = table.try_emplace(ns.name());
+    if (inserted) {
+      _lengths[length / 64] |= 0x1ull << (length % 64);
+      ++_size;
+    }
+
+    return it->second;
+  }
+
+  /**
+   * @brief Value of ns, or nullptr if ns is not in the matcher.
+   */
+  T* find(const Namespace& ns)
+  {
+    auto& table = _tables[canonical_length(ns)];
+    auto it = table.find(ns.name());
+    return it != table.end() ? &it->second : nullptr;
+  }
+
+  const T* find(const Namespace& ns) const
+  {
+    return const_cast<NamespaceMatcher*>(this)->find(ns);
+  }
+
+  /**
+   * @brief Removes ns, and its value, from the matcher.
+   *
+   * @returns Whether ns was in the matcher.
+   */
+  bool erase(const Namespace& ns)
+  {
+    const auto length = canonical_length(ns);
+    auto& table = _tables[length];
+    if (!table.erase(ns.name()))
+      return false;
+
+    if (table.empty())
+      _lengths[length / 64] &= ~(0x1ull << (length % 64));
+
+    --_size;
+    return true;
+  }
+
+  /**
+   * @brief Calls func(const Namespace&, T&) for every namespace that contains
+   *        name, shortest prefix first.
+   */
+  template<typename Func>
+  void for_each_match(const Name& name, Func&& func)
+  {
+    for (size_t word = 0; word < _lengths.size(); ++word) {
+      for (auto bits = _lengths[word]; bits != 0; bits &= bits - 1) {
+        const auto length =
+          static_cast<uint8_t>(word * 64 + std::countr_zero(bits));
+        const auto prefix = name & masks[length];
+
+        auto& table = _tables[length];
+        if (auto it = table.find(prefix); it != table.end())
+          func(Namespace{ prefix, length }, it->second);
+      }
+    }
+  }
+
+  template<typename Func>
+  void for_each_match(const Name& name, Func&& func) const
+  {
+    const_cast<NamespaceMatcher*>(this)->for_each_match(
+      name, [&](const Namespace& ns, T& value) {
+        func(ns, std::as_const(value));
+      });
+  }
+
+  /**
+   * @brief Whether any namespace in the matcher contains name.
+   */
+  bool matches(const Name& name) const
+  {
+    for (size_t word = 0; word < _lengths.size(); ++word) {
+      for (auto bits = _lengths[word]; bits != 0; bits &= bits - 1) {
+        const auto length = word * 64 + std::countr_zero(bits);
+        if (_tables[length].contains(name & masks[length]))
+          return true;
+      }
+    }
+
+    return false;
+  }
+
+  size_t size() const { return _size; }
+  bool empty() const { return _size == 0; }
+
+  void clear()
+  {
+    for (auto& table : _tables)
+      table.clear();
+    _lengths = {};
+    _size = 0;
+  }
+
+private:
+  static constexpr size_t max_length = sizeof(Name) * 8;
+
+  static constexpr std::array<Name, max_length + 1> masks = [] {
+    std::array<Name, max_length + 1> out{};
+    for (size_t length = 0; length <= max_length; ++length)
+      out[length] =
+        Namespace{ ~0x0_name, static_cast<uint8_t>(length) }.mask();
+    return out;
+  }();
+
+  static size_t canonical_length(const Namespace& ns)
+  {
+    return std::min<size_t>(ns.length(), max_length);
+  }
+
+  std::array<uint64_t, (max_length + 64) / 64> _lengths{};
+  std::array<std::unordered_map<Name, T>, max_length + 1> _tables;
+  size_t _size{ 0 };
+};
+
+}
@@ -0,0 +1,225 @@
+#pragma once
+
+#include <quicr/quicr_name.h>
+#include <quicr/quicr_namespace.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <utility>
+
+namespace quicr {
+
+/**
+ * @brief Map of Namespace to T, indexed by prefix.
+ *
+ * @details A compressed binary trie over the bits of the 128 bit name. Each
+ *          node holds a namespace, and its children extend it by at least
+ *          one bit, with chains of single children collapsed into one node.
+ *          Finding every namespace that contains a name therefore visits
+ *          only the populated prefixes along its path, rather than probing
+ *          each of the 129 possible prefix lengths.
+ *
+ *          Not thread safe.
+ */
+template<typename T>
+class NamespaceTrie
+{
+public:
+  /**
+   * @brief Value of ns, default constructed if ns is not in the trie.
+   */
+  T& operator[](const Namespace& ns)
+  {
+    auto& node = insert(canonical(ns));
+    if (!node.value) {
+      node.value.emplace();
+      ++_size;
+    }
+
+    return *node.value;
+  }
+
+  /**
+   * @brief Value of ns, or nullptr if ns is not in the trie.
+   */
+  T* find(const Namespace& ns)
+  {
+    auto node = find_node(canonical(ns));
+    return node && node->value ? &*node->value : nullptr;
+  }
+
+  const T* find(const Namespace& ns) const
+  {
+    return const_cast<NamespaceTrie*>(this)->find(ns);
+  }
+
+  /**
+   * @brief Removes ns, and its value, from the trie.
+   *
+   * @returns Whether ns was in the trie.
+   */
+  bool erase(const Namespace& ns)
+  {
+    if (!erase(_root, canonical(ns)))
+      return false;
+
+    --_size;
+    return true;
+  }
+
+  /**
+   * @brief Calls func(const Namespace&, T&) for every namespace that contains
+   *        name, shortest prefix first.
+   */
+  template<typename Func>
+  void for_each_match(const Name& name, Func&& func)
+  {
+    for (Node* node = _root.get(); node && node->ns.contains(name);
+         node = node->child(name).get()) {
+      if (node->value)
+        func(std::as_const(node->ns), *node->value);
+
+      if (node->ns.length() == max_length)
+        break;
+    }
+  }
+
+  template<typename Func>
+  void for_each_match(const Name& name, Func&& func) const
+  {
+    const_cast<NamespaceTrie*>(this)->for_each_match(
+      name, [&](const Namespace& ns, T& value) {
+        func(ns, std::as_const(value));
+      });
+  }
+
+  size_t size() const { return _size; }
+  bool empty() const { return _size == 0; }
+
+  void clear()
+  {
+    _root = std::make_unique<Node>(Namespace{ 0x0_name, 0 });
+    _size = 0;
+  }
+
+private:
+  static constexpr uint8_t max_length = sizeof(Name) * 8;
+
+  // Bit of name following the first length bits
+  static bool bit(const Name& name, uint8_t length)
+  {
+    if (length < 64)
+      return (name.hi() >> (63 - length)) & 0x1;
+    return (name.low() >> (127 - length)) & 0x1;
+  }
+
+  // Number of leading bits a and b have in common
+  static uint8_t common_length(const Name& a, const Name& b)
+  {
+    const auto hi = a.hi() ^ b.hi();
+    if (hi != 0)
+      return std::countl_zero(hi);
+    return 64 + std::countl_zero(a.low() ^ b.low());
+  }
+
+  static Namespace canonical(const Namespace& ns)
+  {
+    return ns.length() > max_length ? Namespace{ ns.name(), max_length } : ns;
+  }
+
+  struct Node
+  {
+    explicit Node(const Namespace& ns)
+      : ns{ ns }
+    {
+    }
+
+    std::unique_ptr<Node>& child(const Name& name)
+    {
+      return children[bit(name, ns.length())];
+    }
+
+    Namespace ns;
+    std::optional<T> value;
+    std::array<std::unique_ptr<Node>, 2> children;
+  };
+
+  Node& insert(const Namespace& ns)
+  {
+    Node* node = _root.get();
+    while (node->ns.length() < ns.length()) {
+      auto& slot = node->child(ns.name());
+      if (!slot) {
+        slot = std::make_unique<Node>(ns);
+        return *slot;
+      }
+
+      const auto length = std::min(
+        { common_length(slot->ns.name(), ns.name()), slot->ns.length(),
+          ns.length() });
+      if (length == slot->ns.length()) {
+        node = slot.get();
+        continue;
+      }
+
+      // ns diverges from, or ends within, the child's prefix, so split it
+      auto split = std::make_unique<Node>(Namespace{ ns.name(), length });
+      split->child(slot->ns.name()) = std::move(slot);
+      slot = std::move(split);
+      if (length == ns.length())
+        return *slot;
+
+      auto& leaf = slot->child(ns.name());
+      leaf = std::make_unique<Node>(ns);
+      return *leaf;
+    }
+
+    return *node;
+  }
+
+  Node* find_node(const Namespace& ns)
+  {
+    Node* node = _root.get();
+    while (node && node->ns.length() < ns.length() &&
+           node->ns.contains(ns.name()))
+      node = node->child(ns.name()).get();
+
+    return node && node->ns == ns ? node : nullptr;
+  }
+
+  bool erase(std::unique_ptr<Node>& slot, const Namespace& ns)
+  {
+    Node& node = *slot;
+    if (!node.ns.contains(ns.name()) || node.ns.length() > ns.length())
+      return false;
+
+    if (node.ns.length() == ns.length()) {
+      if (!node.value)
+        return false;
+      node.value.reset();
+    } else {
+      auto& child = node.child(ns.name());
+      if (!child || !erase(child, ns))
+        return false;
+    }
+
+    // Collapse nodes that no longer hold a value or a branch
+    if (!node.value && &slot != &_root) {
+      auto& [first, second] = node.children;
+      if (!first || !second)
+        slot = std::move(first ? first : second);
+    }
+
+    return true;
+  }
+
+  std::unique_ptr<Node> _root{ std::make_unique<Node>(
+    Namespace{ 0x0_name, 0 }) };
+  size_t _size{ 0 };
+};
+
+}
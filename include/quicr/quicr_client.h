@@ -1,15 +1,25 @@
 #pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <span>
 #include <string>
+#include <thread>
 #include <vector>
 
+#include <quicr/buffer_pool.h>
 #include <quicr/encode.h>
 #include <quicr/message_buffer.h>
 #include <quicr/quicr_common.h>
 #include <quicr/quicr_name.h>
 #include <quicr/quicr_namespace.h>
+#include <quicr/send_scheduler.h>
+#include <quicr/stream_decoder.h>
+#include <quicr/stream_map.h>
 #include <transport/transport.h>
 
 using qtransport::ITransport;
@@ -259,13 +269,22 @@ public:
    *
    * @param quicr_name               : Identifies the QUICR Name for the object
    * @param priority                 : Identifies the relative priority of the
-   *                                   current object
+   *                                   current object, lower values first
    * @param expiry_age_ms            : Time hint for the object to be in cache
    *                                      before being purged after reception
    * @param use_reliable_transport   : Indicates the preference for the object's
    *                                   transport, if forwarded.
    * @param data                     : Opaque payload
    *
+   * @details Objects are queued per priority and sent highest priority first
+   *          as the transport accepts them. An object still queued once
+   *          expiry_age_ms has passed is dropped instead of sent; zero never
+   *          expires. Objects held back by a full transport queue are retried
+   *          on the next publish or flush().
+   *
+   *          Each priority, reliable or not, is sent on a stream of its own,
+   *          apart from control messages, so a stalled stream only holds
+   *          back objects of its own priority.
    */
   void publishNamedObject(const quicr::Name& quicr_name,
                           uint8_t priority,
@@ -295,20 +314,100 @@ public:
                                   bool is_last_fragment,
                                   bytes&& data);
 
+  /**
+   * @brief Coalesce messages sent on the same stream into batches of up to
+   *        MAX_TRANSPORT_DATA_SIZE bytes per transport payload.
+   *
+   * @details While enabled, published objects are held until the next one no
+   *          longer fits in the batch or flush() is called. Control messages
+   *          and fragments flush the batch ahead of them straight away, so
+   *          they are never delayed. Disabling coalescing flushes any pending
+   *          batches.
+   */
+  void setCoalescing(bool enabled);
+
+  /**
+   * @brief Send any queued objects the transport accepts, and any batched
+   *        messages, now.
+   *
+   * @returns None, or the last error sending them. Batches the transport
+   *          queue had no room for are kept for the next flush.
+   */
+  qtransport::TransportError flush();
+
   void handle(messages::MessageBuffer&& msg);
+  void handle(messages::MessageBufferView&& msg);
+
+  /**
+   * @brief Notes a stream the peer opened. The transport announces only
+   *        reliable streams, so reads from it are framed incrementally.
+   */
+  void handle_new_stream(const qtransport::StreamId& stream_id);
+
+  /**
+   * @brief Handles data read from a stream.
+   *
+   * @details On a stream the peer opened, data may end part way through a
+   *          message, and the rest is expected in the next read. Anything
+   *          else is a datagram, handled whole, and dropped if incomplete.
+   */
+  void handle(const qtransport::StreamId& stream_id,
+              std::span<const uint8_t> data);
   void removeSubscribeState(bool all, const quicr::Namespace& quicr_namespace,
                             const SubscribeResult::SubscribeStatus& reason);
 
   std::shared_ptr<ITransport> transport;
   qtransport::LogHandler& log_handler;
 
+  /**
+   * Pool that encode buffers are drawn from. Received packets are returned to
+   * it once decoded, and a transport can hand sent buffers back through
+   * buffer_pool.release().
+   */
+  messages::BufferPool buffer_pool;
+
 private:
   std::mutex mutex;
 
+  qtransport::TransportError send(const qtransport::StreamId& stream_id,
+                                  std::vector<uint8_t>&& packet,
+                                  bool flush_now);
+
+  // Sends packet, moving from it only if it is taken. The transport leaves
+  // packets it returns QueueFull for with the caller
+  SendScheduler::Result try_send(const qtransport::StreamId& stream_id,
+                                 std::vector<uint8_t>& packet,
+                                 bool flush_now);
+
+  // Sends batch, keeping it if the transport queue is full. Called with
+  // batch_mutex held
+  qtransport::TransportError send_batch(const qtransport::StreamId& stream_id,
+                                        messages::MessageBatch& batch);
+
+  // Queues an object's packet by priority and sends what the transport takes
+  qtransport::TransportError schedule(uint8_t priority,
+                                      uint16_t expiry_age_ms,
+                                      const qtransport::StreamId& stream_id,
+                                      std::vector<uint8_t>&& packet,
+                                      bool flush_now);
+  qtransport::TransportError schedule_fragments(
+    uint8_t priority,
+    uint16_t expiry_age_ms,
+    const qtransport::StreamId& stream_id,
+    std::vector<std::vector<uint8_t>>&& fragments,
+    bool flush_now);
+  // Called with scheduler_mutex held
+  qtransport::TransportError drain_scheduled();
+
+  // Has the retry thread flush after retry_interval, for packets the
+  // transport had no room for
+  void retry_later();
+  void run_retry();
 
   bool notify_pub_fragment(const messages::PublishDatagram& datagram,
                            const std::map<int, bytes>& frag_map);
   void handle_pub_fragment(messages::PublishDatagram&& datagram);
+  void handle_publish(messages::PublishDatagramView&& datagram);
 
   qtransport::LogHandler def_log_handler;
 
@@ -361,6 +460,39 @@ private:
   std::map<quicr::Name, PublishContext> publish_state{};
   std::unique_ptr<ITransport::TransportDelegate> transport_delegate;
   uint64_t transport_stream_id{ 0 };
+
+  // Streams objects are published on, per priority and reliability
+  StreamMap object_streams;
+
+  std::atomic<bool> coalesce{ false };
+  std::mutex batch_mutex;
+  std::map<qtransport::StreamId, messages::MessageBatch> pending_batches;
+
+  // Objects waiting for the transport, locked ahead of batch_mutex
+  std::mutex scheduler_mutex;
+  SendScheduler scheduler;
+
+  // UDP has no congestion control, so sends are paced to pacing_burst bytes
+  // per pacing_interval. Guarded by scheduler_mutex
+  static constexpr size_t pacing_burst = 30 * MAX_TRANSPORT_DATA_SIZE;
+  static constexpr auto pacing_interval = std::chrono::milliseconds(1);
+  SendScheduler::Clock::time_point pacing_start;
+  size_t paced_bytes{ 0 };
+
+  // The transport has no writable callback, so held back packets are
+  // retried on a timer. retry_mutex is locked after any other
+  static constexpr auto retry_interval = std::chrono::milliseconds(1);
+  std::mutex retry_mutex;
+  std::condition_variable retry_cv;
+  bool retry_pending{ false };
+  bool stopping{ false };
+
+  // Partial messages read from each reliable stream
+  std::mutex stream_decoder_mutex;
+  std::map<qtransport::StreamId, messages::StreamDecoder> stream_decoders;
+
+  // Started last, once the members it uses are constructed
+  std::thread retry_thread;
 };
 
 }
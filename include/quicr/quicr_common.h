@@ -17,6 +17,12 @@ namespace quicr {
  */
 constexpr uint16_t MAX_TRANSPORT_DATA_SIZE = 1200;
 
+/**
+ * Max size of an object read from a reliable stream. A larger declared size
+ * is taken as malformed, rather than reading the rest of the stream into it.
+ */
+constexpr uint64_t MAX_STREAM_OBJECT_SIZE = 64 * 1024 * 1024;
+
 // TODO: Do we need a different structure or the name
 using bytes = std::vector<uint8_t>;
 
@@ -42,6 +48,7 @@ enum class MessageType : uint8_t
   PublishIntent,
   PublishIntentResponse,
   PublishIntentEnd,
+  Batch,
 };
 
 /**
@@ -1,12 +1,22 @@
 #pragma once
 
+#include <quicr/hex.h>
+
+#include <compare>
 #include <cstdint>
 #include <cstdlib>
+#include <functional>
+#include <span>
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <type_traits>
 #include <vector>
 
+#if defined(QUICR_NAME_INT128) && defined(__SIZEOF_INT128__)
+#define QUICR_NAME_USE_INT128 1
+#endif
+
 namespace quicr {
 
 constexpr uint64_t
@@ -82,17 +92,27 @@ struct NameException : public std::runtime_error
 
 /**
  * @brief Name class used for passing data in bits.
+ *
+ * @details When built with QUICR_NAME_INT128, and the compiler provides
+ *          unsigned __int128, the name is held as a single 128 bit integer.
+ *          Otherwise it is held as two 64 bit words. Both have the same
+ *          interface and ordering.
  */
 class Name
 {
 public:
   Name() = default;
   constexpr Name(const Name& other) = default;
-  Name(Name&& other) = default;
+  constexpr Name(Name&& other) = default;
   Name(uint8_t* data, size_t length);
   Name(const uint8_t* data, size_t length);
   Name(const std::vector<uint8_t>& data);
 
+  /**
+   * @brief Builds a name from its high and low 64 bits.
+   */
+  constexpr Name(uint64_t hi, uint64_t low) { set(hi, low); }
+
   constexpr Name(std::string_view hex_value)
   {
     if (hex_value.starts_with("0x"))
@@ -102,66 +122,322 @@ public:
       throw NameException("Hex string cannot be longer than " +
                           std::to_string(sizeof(Name) * 2) + " bytes");
 
-    if (hex_value.length() > sizeof(Name)) {
-      _hi = hex_to_uint<uint64_t>(
-        hex_value.substr(0, hex_value.length() - sizeof(Name)));
-      _low = hex_to_uint<uint64_t>(
-        hex_value.substr(hex_value.length() - sizeof(Name), sizeof(Name)));
+    uint64_t hi = 0;
+    uint64_t low = 0;
+
+    // Full length names are read by the vectorised kernel at runtime
+    if (!std::is_constant_evaluated() &&
+        hex_value.length() == sizeof(Name) * 2 &&
+        hex::decode(hex_value.data(), hi, low)) {
+      set(hi, low);
+      return;
+    }
+
+    if (hex_value.length() > sizeof(uint64_t) * 2) {
+      hi = hex_to_uint<uint64_t>(
+        hex_value.substr(0, hex_value.length() - sizeof(uint64_t) * 2));
+      low = hex_to_uint<uint64_t>(hex_value.substr(
+        hex_value.length() - sizeof(uint64_t) * 2, sizeof(uint64_t) * 2));
     } else {
-      _hi = 0;
-      _low = hex_to_uint<uint64_t>(hex_value.substr(0, hex_value.length()));
+      low = hex_to_uint<uint64_t>(hex_value.substr(0, hex_value.length()));
     }
+
+    set(hi, low);
   }
 
   ~Name() = default;
 
+#ifdef QUICR_NAME_USE_INT128
+  constexpr uint64_t hi() const
+  {
+    return static_cast<uint64_t>(_value >> uint64_t_bit_size);
+  }
+  constexpr uint64_t low() const { return static_cast<uint64_t>(_value); }
+#else
+  constexpr uint64_t hi() const { return _hi; }
+  constexpr uint64_t low() const { return _low; }
+#endif
+
+  /**
+   * @brief Length of the hex string of a name, including its "0x" prefix.
+   */
+  static constexpr size_t hex_size = 2 + 4 * sizeof(uint64_t);
+
   std::string to_hex() const;
-  std::uint8_t operator[](std::size_t offset) const;
-
-  Name operator>>(uint16_t value) const;
-  Name operator>>=(uint16_t value);
-  Name operator<<(uint16_t value) const;
-  Name operator<<=(uint16_t value);
-  Name operator+(uint64_t value) const;
-  void operator+=(uint64_t value);
-  Name operator++();
-  Name operator++(int);
-  Name operator--();
-  Name operator--(int);
-  Name operator-(uint64_t value) const;
-  void operator-=(uint64_t value);
-  Name operator&(uint64_t value) const;
-  void operator&=(uint64_t value);
-  Name operator|(uint64_t value) const;
-  void operator|=(uint64_t value);
-  Name operator&(const Name& other) const;
-  void operator&=(const Name& other);
-  Name operator|(const Name& other) const;
-  void operator|=(const Name& other);
-  Name operator^(const Name& other) const;
-  void operator^=(const Name& other);
-
-  constexpr Name operator~() const
+
+  /**
+   * @brief Writes the hex string of the name to out, without allocating.
+   *
+   * @returns View of out holding the hex string.
+   */
+  std::string_view to_hex(std::span<char, hex_size> out) const;
+
+  constexpr std::uint8_t operator[](std::size_t index) const
+  {
+    if (index >= sizeof(Name))
+      throw std::out_of_range(
+        "Cannot access index outside of max size of quicr::Name");
+
+    if (index < sizeof(uint64_t))
+      return (low() >> (index * 8)) & 0xff;
+    return (hi() >> ((index - sizeof(uint64_t)) * 8)) & 0xff;
+  }
+
+  constexpr Name operator>>(uint16_t value) const
+  {
+    Name name(*this);
+    name >>= value;
+    return name;
+  }
+
+  constexpr Name operator>>=(uint16_t value)
+  {
+#ifdef QUICR_NAME_USE_INT128
+    _value = value < 2 * uint64_t_bit_size ? _value >> value : 0;
+#else
+    if (value == 0)
+      return *this;
+
+    if (value < uint64_t_bit_size) {
+      _low = _low >> value;
+      _low |= _hi << (uint64_t_bit_size - value);
+      _hi = _hi >> value;
+    } else if (value < 2 * uint64_t_bit_size) {
+      _low = _hi >> (value - uint64_t_bit_size);
+      _hi = 0;
+    } else {
+      _low = 0;
+      _hi = 0;
+    }
+#endif
+
+    return *this;
+  }
+
+  constexpr Name operator<<(uint16_t value) const
+  {
+    Name name(*this);
+    name <<= value;
+    return name;
+  }
+
+  constexpr Name operator<<=(uint16_t value)
+  {
+#ifdef QUICR_NAME_USE_INT128
+    _value = value < 2 * uint64_t_bit_size ? _value << value : 0;
+#else
+    if (value == 0)
+      return *this;
+
+    if (value < uint64_t_bit_size) {
+      _hi = _hi << value;
+      _hi |= _low >> (uint64_t_bit_size - value);
+      _low = _low << value;
+    } else if (value < 2 * uint64_t_bit_size) {
+      _hi = _low << (value - uint64_t_bit_size);
+      _low = 0;
+    } else {
+      _hi = 0;
+      _low = 0;
+    }
+#endif
+
+    return *this;
+  }
+
+  constexpr Name operator+(uint64_t value) const
+  {
+    Name name(*this);
+    name += value;
+    return name;
+  }
+
+  constexpr void operator+=(uint64_t value)
+  {
+#ifdef QUICR_NAME_USE_INT128
+    _value += value;
+#else
+    if (_low + value < _low) {
+      ++_hi;
+    }
+    _low += value;
+#endif
+  }
+
+  constexpr Name operator-(uint64_t value) const
+  {
+    Name name(*this);
+    name -= value;
+    return name;
+  }
+
+  constexpr void operator-=(uint64_t value)
+  {
+#ifdef QUICR_NAME_USE_INT128
+    _value -= value;
+#else
+    if (_low - value > _low) {
+      --_hi;
+    }
+    _low -= value;
+#endif
+  }
+
+  constexpr Name operator++()
+  {
+    *this += 1;
+    return *this;
+  }
+
+  constexpr Name operator++(int)
+  {
+    Name name(*this);
+    ++(*this);
+    return name;
+  }
+
+  constexpr Name operator--()
+  {
+    *this -= 1;
+    return *this;
+  }
+
+  constexpr Name operator--(int)
+  {
+    Name name(*this);
+    --(*this);
+    return name;
+  }
+
+  constexpr Name operator&(uint64_t value) const
   {
     Name name(*this);
-    name._hi = ~_hi;
-    name._low = ~_low;
+    name &= value;
     return name;
   }
 
+  constexpr void operator&=(uint64_t value)
+  {
+    *this &= Name{ ~uint64_t{ 0 }, value };
+  }
+
+  constexpr Name operator|(uint64_t value) const
+  {
+    Name name(*this);
+    name |= value;
+    return name;
+  }
+
+  constexpr void operator|=(uint64_t value)
+  {
+    *this |= Name{ uint64_t{ 0 }, value };
+  }
+
+  constexpr Name operator&(const Name& other) const
+  {
+    Name name = *this;
+    name &= other;
+    return name;
+  }
+
+  constexpr void operator&=(const Name& other)
+  {
+#ifdef QUICR_NAME_USE_INT128
+    _value &= other._value;
+#else
+    _hi &= other._hi;
+    _low &= other._low;
+#endif
+  }
+
+  constexpr Name operator|(const Name& other) const
+  {
+    Name name = *this;
+    name |= other;
+    return name;
+  }
+
+  constexpr void operator|=(const Name& other)
+  {
+#ifdef QUICR_NAME_USE_INT128
+    _value |= other._value;
+#else
+    _hi |= other._hi;
+    _low |= other._low;
+#endif
+  }
+
+  constexpr Name operator^(const Name& other) const
+  {
+    Name name = *this;
+    name ^= other;
+    return name;
+  }
+
+  constexpr void operator^=(const Name& other)
+  {
+#ifdef QUICR_NAME_USE_INT128
+    _value ^= other._value;
+#else
+    _hi ^= other._hi;
+    _low ^= other._low;
+#endif
+  }
+
+  constexpr Name operator~() const { return Name{ ~hi(), ~low() }; }
+
   constexpr Name& operator=(const Name& other) = default;
   constexpr Name& operator=(Name&& other) = default;
 
-  friend bool operator<(const Name& a, const Name& b);
-  friend bool operator>(const Name& a, const Name& b);
-  friend bool operator==(const Name& a, const Name& b);
-  friend bool operator!=(const Name& a, const Name& b);
+  /**
+   * @brief Names are ordered as unsigned 128 bit integers.
+   */
+  friend constexpr auto operator<=>(const Name& a, const Name& b) = default;
+  friend constexpr bool operator==(const Name& a, const Name& b) = default;
 
   friend std::ostream& operator<<(std::ostream& os, const Name& name);
 
 private:
+  static constexpr uint16_t uint64_t_bit_size = sizeof(uint64_t) * 8;
+
+#ifdef QUICR_NAME_USE_INT128
+  __extension__ typedef unsigned __int128 uint128_t;
+
+  constexpr void set(uint64_t hi, uint64_t low)
+  {
+    _value = (static_cast<uint128_t>(hi) << uint64_t_bit_size) | low;
+  }
+
+  uint128_t _value;
+#else
+  constexpr void set(uint64_t hi, uint64_t low)
+  {
+    _hi = hi;
+    _low = low;
+  }
+
+  // Declared most significant first, so the defaulted comparisons order
+  // names numerically
   uint64_t _hi;
   uint64_t _low;
+#endif
+};
+}
+
+namespace std {
+template<>
+struct hash<quicr::Name>
+{
+  constexpr size_t operator()(const quicr::Name& name) const noexcept
+  {
+    // Names usually share their high bits, and differ in the low bits of
+    // each word, so mix both words through a multiply and fold
+    uint64_t value = name.hi() * 0x9E3779B97F4A7C15ull ^ name.low();
+    value ^= value >> 32;
+    value *= 0xD6E8FEB86659FD93ull;
+    value ^= value >> 32;
+    return static_cast<size_t>(value);
+  }
 };
 }
 
@@ -14,35 +14,100 @@ class Namespace
 public:
   Namespace() = default;
   constexpr Namespace(const Namespace& ns) = default;
-  Namespace(Namespace&& ns) = default;
-  Namespace(const Name& name, uint8_t sig_bits);
-  Namespace(Name&& name, uint8_t sig_bits);
+  constexpr Namespace(Namespace&& ns) = default;
 
-  Namespace& operator=(const Namespace& other) = default;
-  Namespace& operator=(Namespace&& other) = default;
+  constexpr Namespace(const Name& name, uint8_t sig_bits)
+    : _name{ name & make_mask(sig_bits) }
+    , _mask{ make_mask(sig_bits) }
+    , _sig_bits{ sig_bits }
+  {
+  }
 
-  bool contains(const Name& name) const;
-  bool contains(const Namespace& prefix) const { return contains(prefix._name); }
+  constexpr Namespace& operator=(const Namespace& other) = default;
+  constexpr Namespace& operator=(Namespace&& other) = default;
+
+  constexpr bool contains(const Name& name) const
+  {
+    return (name & _mask) == _name;
+  }
+
+  constexpr bool contains(const Namespace& prefix) const
+  {
+    return contains(prefix._name);
+  }
 
   constexpr Name name() const { return _name; }
   constexpr uint8_t length() const { return _sig_bits; }
+
+  /**
+   * @brief Mask of the significant bits of the namespace.
+   */
+  constexpr Name mask() const { return _mask; }
+
   std::string to_hex() const;
 
-  friend bool operator==(const Namespace& a, const Namespace& b);
-  friend bool operator!=(const Namespace& a, const Namespace& b);
+  friend constexpr bool operator==(const Namespace& a, const Namespace& b)
+  {
+    return a._name == b._name && a._sig_bits == b._sig_bits;
+  }
+
+  friend constexpr bool operator!=(const Namespace& a, const Namespace& b)
+  {
+    return !(a == b);
+  }
+
+  friend constexpr bool operator>(const Namespace& a, const Namespace& b)
+  {
+    return a._name > b._name;
+  }
+
+  friend constexpr bool operator>(const Namespace& a, const Name& b)
+  {
+    return a._name > b;
+  }
 
-  friend bool operator>(const Namespace& a, const Namespace& b);
-  friend bool operator>(const Namespace& a, const Name& b);
-  friend bool operator>(const Name& a, const Namespace& b);
+  friend constexpr bool operator>(const Name& a, const Namespace& b)
+  {
+    return a > b._name;
+  }
 
-  friend bool operator<(const Namespace& a, const Namespace& b);
-  friend bool operator<(const Namespace& a, const Name& b);
-  friend bool operator<(const Name& a, const Namespace& b);
+  friend constexpr bool operator<(const Namespace& a, const Namespace& b)
+  {
+    return a._name < b._name;
+  }
+
+  friend constexpr bool operator<(const Namespace& a, const Name& b)
+  {
+    return a._name < b;
+  }
+
+  friend constexpr bool operator<(const Name& a, const Namespace& b)
+  {
+    return a < b._name;
+  }
 
   friend std::ostream& operator<<(std::ostream& os, const Namespace& ns);
 
 private:
+  static constexpr Name make_mask(uint8_t sig_bits)
+  {
+    return ~(~0x0_name >> sig_bits);
+  }
+
   Name _name;
+  Name _mask;
   uint8_t _sig_bits;
 };
 }
+
+namespace std {
+template<>
+struct hash<quicr::Namespace>
+{
+  constexpr size_t operator()(const quicr::Namespace& ns) const noexcept
+  {
+    // Bits past the prefix are zero, which leaves room for the length
+    return hash<quicr::Name>{}(ns.name() + ns.length());
+  }
+};
+}
@@ -1,15 +1,27 @@
 #pragma once
 
+#include <atomic>
 #include <map>
+#include <memory>
 #include <optional>
+#include <shared_mutex>
+#include <span>
 #include <string>
 #include <thread>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 #include <mutex>
 
+#include <quicr/buffer_pool.h>
 #include <quicr/encode.h>
 #include <quicr/message_buffer.h>
+#include <quicr/mpmc_queue.h>
+#include <quicr/name_map.h>
+#include <quicr/namespace_matcher.h>
 #include <quicr/quicr_common.h>
+#include <quicr/stream_decoder.h>
+#include <quicr/stream_map.h>
 #include <transport/transport.h>
 
 /*
@@ -81,6 +93,30 @@ public:
     bool use_reliable_transport,
     messages::PublishDatagram&& datagram) = 0;
 
+  /**
+   * @brief Reports arrival of a QUICR object as the bytes it was received
+   *        in, for relays that forward objects without decoding them
+   *
+   * @param context_id               : Context id the message was received on
+   * @param stream_id                : Stream ID the message was received on
+   * @param use_reliable_transport   : Indicates the preference for the object's
+   *                                   transport, if forwarded.
+   * @param header                   : Header of the object
+   * @param encoded                  : Encoded Publish message, only valid
+   *                                   during the call
+   *
+   * @details The bytes can be forwarded unchanged to subscribers with
+   *          QuicRServer::sendEncodedObject(). Overriding this callback
+   *          replaces onPublisherObject; the default implementation decodes
+   *          the object and calls onPublisherObject with it.
+   */
+  virtual void onPublisherObjectBytes(
+    const qtransport::TransportContextId& context_id,
+    const qtransport::StreamId& stream_id,
+    bool use_reliable_transport,
+    const messages::Header& header,
+    std::span<const uint8_t> encoded);
+
   /**
    * @brief Report arrival of subscribe request for a QUICR Namespace
    *
@@ -158,6 +194,8 @@ public:
     ServerDelegate& delegate /* TODO: Considering shared or weak pointer */,
     qtransport::LogHandler& logger);
 
+  ~QuicRServer();
+
   // Transport APIs
   bool is_transport_ready();
 
@@ -218,16 +256,159 @@ public:
   /**
    * @brief Send a named QUICR media object
    *
+   * @details Objects are sent on a stream of the subscriber's connection per
+   *          priority and use_reliable_transport, apart from its control
+   *          messages, so objects of one priority are not held behind
+   *          another's. Priority is not sent on the wire, so a relay chooses
+   *          it, such as from the stream the object was received on.
+   *
    * @param subscriber_id            : Subscriber ID to send the message to
+   * @param priority                 : Identifies the relative priority of the
+   *                                   current object, lower values first
    * @param use_reliable_transport   : Indicates the preference for the object's
    *                                   transport, if forwarded.
    * @param datagram                 : QuicR Publish Datagram to send
    *
    */
   void sendNamedObject(const uint64_t& subscriber_id,
+                       uint8_t priority,
+                       bool use_reliable_transport,
+                       const messages::PublishDatagram& datagram);
+
+  /**
+   * @brief Send a named QUICR media object to a subscriber's connection and
+   *        stream, as reported to onSubscribe, without looking up its
+   *        subscriber ID.
+   *
+   * @details The object is sent on the connection's stream for its priority
+   *          and reliability, as with sendNamedObject(subscriber_id, ...).
+   *
+   * @param context_id               : Context ID of the subscriber
+   * @param stream_id                : Stream ID of the subscriber
+   * @param priority                 : Identifies the relative priority of the
+   *                                   current object, lower values first
+   * @param use_reliable_transport   : Indicates the preference for the object's
+   *                                   transport, if forwarded.
+   * @param datagram                 : QuicR Publish Datagram to send
+   */
+  void sendNamedObject(const qtransport::TransportContextId& context_id,
+                       const qtransport::StreamId& stream_id,
+                       uint8_t priority,
                        bool use_reliable_transport,
                        const messages::PublishDatagram& datagram);
 
+  /**
+   * @brief Send a named QUICR media object to many subscribers, encoding it
+   *        only once.
+   *
+   * @details Each subscriber is still sent a copy of the encoded bytes, as
+   *          with sendEncodedObject().
+   *
+   * @param subscriber_ids           : Subscriber IDs to send the message to.
+   *                                   Unknown IDs are skipped.
+   * @param priority                 : Identifies the relative priority of the
+   *                                   current object, lower values first
+   * @param use_reliable_transport   : Indicates the preference for the object's
+   *                                   transport, if forwarded.
+   * @param datagram                 : QuicR Publish Datagram to send
+   */
+  void sendNamedObjectToMany(std::span<const uint64_t> subscriber_ids,
+                             uint8_t priority,
+                             bool use_reliable_transport,
+                             const messages::PublishDatagram& datagram);
+
+  /**
+   * @brief Encode a named QUICR media object, to send it to many
+   *        destinations with sendEncodedObject().
+   */
+  messages::MessageBuffer encodeNamedObject(
+    const messages::PublishDatagram& datagram);
+
+  /**
+   * @brief Send a named QUICR media object encoded by encodeNamedObject().
+   *
+   * @details Each call still copies all of encoded, once per destination.
+   *          ITransport::enqueue() takes ownership of a vector of its own for
+   *          each packet, so one reference counted buffer cannot be shared
+   *          between destinations. What fan-out saves is encoding the object
+   *          again, and allocating: the copy goes into a buffer drawn from
+   *          buffer_pool, which the transport can hand back once sent.
+   *
+   * @param context_id               : Context ID of the subscriber
+   * @param stream_id                : Stream ID of the subscriber
+   * @param priority                 : Identifies the relative priority of the
+   *                                   current object, lower values first
+   * @param use_reliable_transport   : Indicates the preference for the object's
+   *                                   transport, if forwarded.
+   * @param encoded                  : Bytes of the encoded object
+   */
+  void sendEncodedObject(const qtransport::TransportContextId& context_id,
+                         const qtransport::StreamId& stream_id,
+                         uint8_t priority,
+                         bool use_reliable_transport,
+                         std::span<const uint8_t> encoded);
+
+  /**
+   * @brief Forward a named QUICR media object, as reported by
+   *        ServerDelegate::onPublisherObjectBytes(), to a subscriber.
+   *
+   * @details Priority is not on the wire, but publishers send each priority
+   *          on a stream of their own. Objects are therefore sent on a stream
+   *          of the subscriber's for each stream they were received on, so
+   *          objects the publisher kept apart stay apart. Copies encoded, as
+   *          sendEncodedObject() does.
+   *
+   * @param context_id               : Context ID of the subscriber
+   * @param source_context_id        : Context ID the object was received on
+   * @param source_stream_id         : Stream ID the object was received on
+   * @param use_reliable_transport   : Indicates the preference for the object's
+   *                                   transport, if forwarded.
+   * @param encoded                  : Bytes of the encoded object
+   */
+  void forwardEncodedObject(
+    const qtransport::TransportContextId& context_id,
+    const qtransport::TransportContextId& source_context_id,
+    const qtransport::StreamId& source_stream_id,
+    bool use_reliable_transport,
+    std::span<const uint8_t> encoded);
+
+  /**
+   * @brief Coalesce messages sent to the same subscriber stream into batches
+   *        of up to MAX_TRANSPORT_DATA_SIZE bytes per transport payload.
+   *
+   * @details While enabled, named objects are held until the next one no
+   *          longer fits in the batch or flush() is called. Responses flush
+   *          the batch ahead of them straight away. Disabling coalescing
+   *          flushes any pending batches.
+   */
+  void setCoalescing(bool enabled);
+
+  /**
+   * @brief Send any batched messages now.
+   *
+   * @returns None, or the last error sending them. Batches the transport
+   *          queue had no room for are kept for the next flush.
+   */
+  qtransport::TransportError flush();
+
+  /**
+   * @brief Handle received messages on count worker threads, rather than on
+   *        the transport's callback thread.
+   *
+   * @details Each connection is dispatched to a worker by the hash of its
+   *          context id, so its messages are still handled in order, by one
+   *          thread. Published object state is sharded per worker. Delegate
+   *          callbacks are then made concurrently from the workers, and must
+   *          be thread safe. Zero, the default, handles messages on the
+   *          transport's thread.
+   *
+   *          A worker that falls a full queue behind holds the transport's
+   *          thread back until it catches up, rather than dropping reads.
+   *
+   * @throws std::runtime_error if called after run(), or more than once.
+   */
+  void setReceiveWorkers(size_t count);
+
 private:
   /*
    * Implementation of the transport delegate
@@ -255,33 +436,72 @@ private:
   };
 
 public:
-  std::mutex mutex;
+  // Guards subscribe_state, subscribe_id_state and subscriber_id. Lookups
+  // for each object sent share it, changes to subscriptions lock it whole
+  std::shared_mutex mutex;
+
+  /**
+   * Pool that encode buffers are drawn from. Received packets are returned to
+   * it once decoded, and a transport can hand sent buffers back through
+   * buffer_pool.release().
+   */
+  messages::BufferPool buffer_pool;
 
 private:
 
   std::shared_ptr<qtransport::ITransport> setupTransport(
     RelayInfo& relayInfo, qtransport::TransportConfig cfg);
 
+  qtransport::TransportError send(
+    const qtransport::TransportContextId& context_id,
+    const qtransport::StreamId& stream_id,
+    std::vector<uint8_t>&& packet,
+    bool flush_now);
+
+  // Sends batch, keeping it if the transport queue is full. Called with
+  // batch_mutex held
+  qtransport::TransportError send_batch(
+    const qtransport::TransportContextId& context_id,
+    const qtransport::StreamId& stream_id,
+    messages::MessageBatch& batch);
+
+  struct PublishShard;
+
+  void handle(PublishShard& shard,
+              const qtransport::TransportContextId& context_id,
+              const qtransport::StreamId& streamId,
+              messages::MessageBufferView&& msg);
   void handle_subscribe(const qtransport::TransportContextId& context_id,
                         const qtransport::StreamId& streamId,
-                        messages::MessageBuffer&& msg);
+                        messages::MessageBufferView&& msg);
   void handle_unsubscribe(const qtransport::TransportContextId& context_id,
                           const qtransport::StreamId& streamId,
-                          messages::MessageBuffer&& msg);
-  void handle_publish(const qtransport::TransportContextId& context_id,
+                          messages::MessageBufferView&& msg);
+  void handle_publish(PublishShard& shard,
+                      const qtransport::TransportContextId& context_id,
                       const qtransport::StreamId& streamId,
-                      messages::MessageBuffer&& msg);
+                      messages::MessageBufferView&& msg);
+  void handle_publish_fragment(PublishShard& shard,
+                               const qtransport::TransportContextId& context_id,
+                               const qtransport::StreamId& streamId,
+                               messages::PublishDatagramView&& fragment);
+  void handle_publish_object(PublishShard& shard,
+                             const qtransport::TransportContextId& context_id,
+                             const qtransport::StreamId& streamId,
+                             const messages::Header& header,
+                             std::span<const uint8_t> encoded);
   void handle_publish_intent(const qtransport::TransportContextId& context_id,
                              const qtransport::StreamId& mStreamId,
-                             messages::MessageBuffer&& msg);
+                             messages::MessageBufferView&& msg);
   void handle_publish_intent_response(
     const qtransport::TransportContextId& context_id,
     const qtransport::StreamId& mStreamId,
-    messages::MessageBuffer&& msg);
+    messages::MessageBufferView&& msg);
   void handle_publish_intent_end(
+    PublishShard& shard,
     const qtransport::TransportContextId& context_id,
     const qtransport::StreamId& mStreamId,
-    messages::MessageBuffer&& msg);
+    messages::MessageBufferView&& msg);
 
   struct Context
   {
@@ -315,6 +535,58 @@ private:
     uint64_t transaction_id{ 0 };
   };
 
+  // Published object state of the connections handled by one thread
+  struct PublishShard
+  {
+    void end_publish_intent(const quicr::Namespace& quicr_namespace);
+
+    NameMap<PublishContext> publish_state;
+
+    // Names in publish_state under each publish intent, removed at its end
+    std::unordered_map<quicr::Namespace, std::unordered_set<quicr::Name>>
+      intent_names;
+  };
+
+  struct ReceiveWorker
+  {
+    static constexpr size_t queue_size = 4096;
+
+    // Stream with data to read
+    struct Task
+    {
+      qtransport::TransportContextId context_id{ 0 };
+      qtransport::StreamId stream_id{ 0 };
+    };
+
+    MPMCQueue<Task> tasks{ queue_size };
+
+    // Publish intents ended by other workers, to remove from this shard
+    MPMCQueue<quicr::Namespace> ended_intents{ queue_size };
+
+    PublishShard shard;
+
+    // Bumped after each push, and waited on by the worker when idle
+    std::atomic<uint64_t> signal{ 0 };
+
+    // Bumped after each drain of tasks, and waited on by the transport's
+    // thread while tasks is full
+    std::atomic<uint64_t> drained{ 0 };
+    std::atomic<bool> stopping{ false };
+    std::thread thread;
+  };
+
+  void receive(PublishShard& shard,
+               const qtransport::TransportContextId& context_id,
+               const qtransport::StreamId& streamId);
+  void dispatch(const qtransport::TransportContextId& context_id,
+                ReceiveWorker::Task&& task);
+  void run_worker(ReceiveWorker& worker);
+  void stop_workers();
+  ReceiveWorker& worker_for(const qtransport::TransportContextId& context_id);
+  std::span<const std::unique_ptr<ReceiveWorker>> workers() const;
+  void end_publish_intent(PublishShard& shard,
+                          const quicr::Namespace& quicr_namespace);
+
   ServerDelegate& delegate;
   qtransport::LogHandler& log_handler;
   TransportDelegate transport_delegate;
@@ -324,10 +596,37 @@ private:
            std::map<qtransport::TransportContextId, SubscribeContext>>
     subscribe_state{};
   std::map<uint64_t, SubscribeContext> subscribe_id_state{};
-  std::map<quicr::Name, PublishContext> publish_state{};
-  std::map<quicr::Namespace, PublishIntentContext> publish_namespaces{};
+
+  // Read on every publish, so readers share the lock
+  std::shared_mutex publish_namespaces_mutex;
+  NamespaceMatcher<PublishIntentContext> publish_namespaces{};
+
+  // Shard used when messages are handled on the transport's thread
+  PublishShard publish_shard;
+  std::vector<std::unique_ptr<ReceiveWorker>> receive_workers;
+
+  // Size of receive_workers, published once its workers are running, as
+  // transport threads may already be calling back
+  std::atomic<size_t> receive_worker_count{ 0 };
   bool running{ false };
   uint64_t subscriber_id{ 0 };
+
+  // Streams objects are sent on, per connection, priority and reliability,
+  // or per connection and the stream forwarded objects were received on
+  StreamMap object_streams;
+
+  std::atomic<bool> coalesce{ false };
+  std::mutex batch_mutex;
+  std::map<std::pair<qtransport::TransportContextId, qtransport::StreamId>,
+           messages::MessageBatch>
+    pending_batches;
+
+  // Partial messages read from each reliable stream. Shared with the worker
+  // reading the stream, so a disconnect can forget them meanwhile
+  std::mutex stream_decoder_mutex;
+  std::map<std::pair<qtransport::TransportContextId, qtransport::StreamId>,
+           std::shared_ptr<messages::StreamDecoder>>
+    stream_decoders;
 };
 
 } // namespace quicr
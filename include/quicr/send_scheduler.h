@@ -0,0 +1,172 @@
+#pragma once
+
+#include <transport/transport.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <vector>
+
+namespace quicr {
+
+/**
+ * @brief Per-priority queues of encoded objects waiting for the transport.
+ *
+ * @details Objects are queued by priority, where a lower value is a higher
+ *          priority, and drained highest priority first, in the order they
+ *          were pushed within a priority. An object pushed with an expiry age
+ *          is dropped, rather than sent, once that age has passed, so under
+ *          congestion stale objects make way for newer ones instead of
+ *          delaying them. An expiry age of zero never expires.
+ *
+ *          An object may be pushed as several packets, such as the fragments
+ *          of one too large for a single packet. It expires whole: once its
+ *          first packet is sent, the rest are sent however old they get.
+ *
+ *          A stream whose packet the transport does not take is full for the
+ *          rest of the drain. Its packets stay queued, in order, for the next
+ *          drain, while those of other streams carry on.
+ *
+ *          Not thread safe.
+ */
+class SendScheduler
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  /**
+   * @brief Outcome of offering a packet to the transport.
+   */
+  struct Result
+  {
+    // Whether the packet was taken, and must not be offered again
+    bool taken{ false };
+    qtransport::TransportError error{ qtransport::TransportError::None };
+  };
+
+  /**
+   * @brief Queues an object of one packet for stream_id at priority.
+   *
+   * @param flush_now Passed back to send when the packet is drained.
+   */
+  void push(uint8_t priority,
+            uint16_t expiry_age_ms,
+            const qtransport::StreamId& stream_id,
+            std::vector<uint8_t>&& packet,
+            bool flush_now,
+            Clock::time_point now = Clock::now());
+
+  /**
+   * @brief Queues an object of several packets, sent in order, for
+   *        stream_id at priority.
+   */
+  void push_fragments(uint8_t priority,
+                      uint16_t expiry_age_ms,
+                      const qtransport::StreamId& stream_id,
+                      std::vector<std::vector<uint8_t>>&& packets,
+                      bool flush_now,
+                      Clock::time_point now = Clock::now());
+
+  /**
+   * @brief Offers queued packets, highest priority first, to
+   *        send(stream_id, std::vector<uint8_t>& packet, flush_now), which
+   *        returns a Result, and moves from packet only if it takes it.
+   *
+   * @returns The last error send returned other than None, or None.
+   */
+  template<typename Send>
+  qtransport::TransportError drain(Send&& send,
+                                   Clock::time_point now = Clock::now())
+  {
+    auto error = qtransport::TransportError::None;
+
+    // Streams that took no more this drain, usually none
+    std::vector<qtransport::StreamId> full;
+    const auto is_full = [&full](const qtransport::StreamId& stream_id) {
+      return std::find(full.begin(), full.end(), stream_id) != full.end();
+    };
+
+    for (auto queue_it = _queues.begin(); queue_it != _queues.end();) {
+      auto& queue = queue_it->second;
+
+      for (auto it = queue.begin(); it != queue.end();) {
+        if (is_full(it->stream_id)) {
+          ++it;
+          continue;
+        }
+
+        if (it->first && it->deadline <= now) {
+          it = expire(queue, it);
+          continue;
+        }
+
+        const auto result = send(it->stream_id, it->packet, it->flush_now);
+        if (result.error != qtransport::TransportError::None)
+          error = result.error;
+
+        if (!result.taken ||
+            result.error == qtransport::TransportError::QueueFull)
+          full.push_back(it->stream_id);
+
+        if (!result.taken) {
+          ++it;
+          continue;
+        }
+
+        // The rest of the object follows, however old it gets
+        if (!it->last)
+          std::next(it)->first = false;
+
+        it = queue.erase(it);
+        --_size;
+      }
+
+      if (queue.empty())
+        queue_it = _queues.erase(queue_it);
+      else
+        ++queue_it;
+    }
+
+    return error;
+  }
+
+  /**
+   * @brief Number of packets queued.
+   */
+  size_t size() const { return _size; }
+  bool empty() const { return _size == 0; }
+
+  /**
+   * @brief Number of objects dropped for having expired while queued.
+   */
+  uint64_t expired() const { return _expired; }
+
+private:
+  struct Entry
+  {
+    qtransport::StreamId stream_id;
+    std::vector<uint8_t> packet;
+    Clock::time_point deadline;
+    bool flush_now;
+
+    // Whether the packet starts or ends its object. Packets of an object are
+    // queued next to each other
+    bool first;
+    bool last;
+  };
+
+  static Clock::time_point deadline(uint16_t expiry_age_ms,
+                                    Clock::time_point now);
+
+  // Drops the unsent object whose first packet is at it
+  std::deque<Entry>::iterator expire(std::deque<Entry>& queue,
+                                     std::deque<Entry>::iterator it);
+
+  std::map<uint8_t, std::deque<Entry>> _queues;
+  size_t _size{ 0 };
+  uint64_t _expired{ 0 };
+};
+
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+namespace quicr {
+
+/**
+ * @brief Immutable, reference counted value of type T, that readers load
+ *        without taking a lock.
+ *
+ * @details Writers take lock(), build a new T from get(), and store() it.
+ *          Each thread keeps the value it last loaded, and only reloads it
+ *          under the lock after a store, so a load is an atomic read and a
+ *          reference count increment. The pointer load() returns keeps its
+ *          value alive for as long as the caller holds it, whatever the
+ *          thread loads afterwards.
+ *
+ *          Suits values that change far less often than they are read.
+ *
+ *          A thread keeps the values of up to cache_slots snapshots of the
+ *          same T, picked by instance, so reading a few in turn still hits
+ *          its cache. Snapshots sharing a slot evict each other's value, and
+ *          a load after an eviction takes the lock.
+ *
+ *          Thread safe.
+ */
+template<typename T>
+class Snapshot
+{
+public:
+  /**
+   * @brief Current value.
+   */
+  std::shared_ptr<const T> load() const
+  {
+    // Shared by every Snapshot<T> the thread reads, so tagged by owner
+    thread_local std::array<Cache, cache_slots> caches;
+    auto& cache = caches[_id % cache_slots];
+
+    if (cache.owner != _id ||
+        cache.version != _version.load(std::memory_order_acquire)) {
+      std::lock_guard<std::mutex> lock(_mutex);
+      cache = { _id, _version.load(std::memory_order_relaxed), _value };
+    }
+
+    return cache.value;
+  }
+
+  /**
+   * @brief Lock held by writers, around get() and store().
+   */
+  std::unique_lock<std::mutex> lock() const
+  {
+    return std::unique_lock<std::mutex>(_mutex);
+  }
+
+  /**
+   * @brief Current value. Called with lock() held.
+   */
+  const T& get() const { return *_value; }
+
+  /**
+   * @brief Replaces the value. Called with lock() held.
+   */
+  void store(std::shared_ptr<const T>&& value)
+  {
+    _value = std::move(value);
+    _version.fetch_add(1, std::memory_order_release);
+  }
+
+  static constexpr size_t cache_slots = 8;
+
+private:
+  // Value last loaded by the calling thread
+  struct Cache
+  {
+    uint64_t owner{ 0 };
+    uint64_t version{ 0 };
+    std::shared_ptr<const T> value;
+  };
+
+  static inline std::atomic<uint64_t> next_id{ 1 };
+
+  const uint64_t _id{ next_id.fetch_add(1, std::memory_order_relaxed) };
+  mutable std::mutex _mutex;
+  std::atomic<uint64_t> _version{ 0 };
+  std::shared_ptr<const T> _value{ std::make_shared<T>() };
+};
+
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <quicr/encode.h>
+#include <quicr/message_buffer.h>
+#include <quicr/quicr_common.h>
+
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace quicr::messages {
+
+/**
+ * @brief Incremental decoder for messages read from a reliable stream.
+ *
+ * @details A stream may split or join messages arbitrarily across reads, so
+ *          each read is pushed as a chunk, and the decoder yields every
+ *          message completed by it. Bytes of an incomplete message are kept
+ *          until the next chunk; keep one decoder per transport context and
+ *          stream.
+ *
+ *          A Publish whose payload is not yet complete is not buffered.
+ *          Its payload is yielded as it arrives, as PublishDatagramView
+ *          fragments of at most max_fragment_size bytes. The fragment
+ *          offsets are encoded in offset_and_fin, in the same way
+ *          publishers fragment objects over datagrams, so fragments are
+ *          handled and relayed like datagram fragments. A Publish
+ *          declaring more than max_object_size bytes of payload is
+ *          malformed.
+ *
+ *          Messages that arrive whole in one chunk are passed on as views
+ *          of that chunk, without copying. Batches are framed by their total
+ *          length and buffered until complete, like other messages.
+ *
+ *          Datagrams are not framed by a decoder: each is a message of its
+ *          own, and one that is incomplete is dropped, rather than joined
+ *          to the next.
+ */
+class StreamDecoder
+{
+public:
+  explicit StreamDecoder(size_t max_fragment_size = MAX_TRANSPORT_DATA_SIZE,
+                         uint64_t max_object_size = MAX_STREAM_OBJECT_SIZE);
+
+  /**
+   * @brief Decodes the messages completed by chunk.
+   *
+   * @details Whole messages are passed to on_message as a MessageBufferView,
+   *          and object fragments to on_fragment as a PublishDatagramView.
+   *          Both refer to bytes that are only valid during the call.
+   *
+   * @returns DecodeStatus::Ok once chunk has been consumed. On any other
+   *          status the stream cannot be framed anymore; the decoder is
+   *          reset and the stream should be closed.
+   */
+  template<typename MessageHandler, typename FragmentHandler>
+  DecodeStatus push(std::span<const uint8_t> chunk,
+                    MessageHandler&& on_message,
+                    FragmentHandler&& on_fragment)
+  {
+    begin(chunk);
+
+    Frame frame;
+    DecodeStatus status;
+    while ((status = next(frame)) == DecodeStatus::Ok) {
+      if (frame.fragment)
+        on_fragment(std::move(*frame.fragment));
+      else
+        on_message(MessageBufferView{ frame.message });
+    }
+
+    if (status != DecodeStatus::Truncated) {
+      reset();
+      return status;
+    }
+
+    end();
+    return DecodeStatus::Ok;
+  }
+
+  /**
+   * @brief Whether the decoder is between messages.
+   */
+  bool idle() const { return _pending.empty() && !_object; }
+
+  void reset();
+
+private:
+  struct Frame
+  {
+    std::span<const uint8_t> message;
+    std::optional<PublishDatagramView> fragment;
+  };
+
+  // Publish message whose payload is still being read
+  struct Object
+  {
+    Header header;
+    MediaType media_type;
+    uint64_t size;
+    uint64_t offset;
+  };
+
+  void begin(std::span<const uint8_t> chunk);
+  DecodeStatus next(Frame& frame);
+  void end();
+
+  size_t _max_fragment_size;
+  uint64_t _max_object_size;
+
+  std::vector<uint8_t> _pending;
+  std::span<const uint8_t> _input;
+  bool _input_is_pending{ false };
+  std::optional<Object> _object;
+};
+
+}
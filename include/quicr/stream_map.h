@@ -0,0 +1,174 @@
+#pragma once
+
+#include <quicr/snapshot.h>
+#include <transport/transport.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace quicr {
+
+/**
+ * @brief Transport streams that objects are sent on, per connection,
+ *        priority and reliability.
+ *
+ * @details Objects of each priority get a stream of their own, reliable or
+ *          not, so an object held back by loss or congestion only delays
+ *          objects of the same priority, rather than every object queued
+ *          behind it on the connection. Streams are opened on first use.
+ *          Priorities from max_priority on share one stream, so a connection
+ *          has at most 2 * (max_priority + 1) of them, whatever priorities
+ *          its objects are sent with.
+ *
+ *          Objects forwarded from a publisher, whose priority is not on the
+ *          wire, instead get a stream for each stream they were received
+ *          on. Publishers send each priority on a stream of its own, so
+ *          forwarded objects stay apart in the same way.
+ *
+ *          Streams are not closed when their connection is forgotten; the
+ *          transport closes them with it. Streams for objects forwarded from
+ *          a connection are returned when it is forgotten, to be closed.
+ *
+ *          The map is a Snapshot, so looking up a stream for each object
+ *          sent takes no lock. Opening a stream copies the map.
+ *
+ *          Thread safe.
+ */
+class StreamMap
+{
+public:
+  static constexpr uint8_t max_priority = 7;
+
+  /**
+   * @brief Stream of context_id for objects of priority and reliability,
+   *        opened on transport if it has none yet.
+   */
+  qtransport::StreamId get(qtransport::ITransport& transport,
+                           const qtransport::TransportContextId& context_id,
+                           uint8_t priority,
+                           bool reliable)
+  {
+    return get(
+      transport,
+      { context_id, std::min(priority, max_priority), reliable, std::nullopt });
+  }
+
+  /**
+   * @brief Stream of context_id for objects received on source_stream_id of
+   *        source_context_id, opened on transport if it has none yet.
+   */
+  qtransport::StreamId get(
+    qtransport::ITransport& transport,
+    const qtransport::TransportContextId& context_id,
+    const qtransport::TransportContextId& source_context_id,
+    const qtransport::StreamId& source_stream_id,
+    bool reliable)
+  {
+    const std::pair source{ source_context_id, source_stream_id };
+    return get(transport, { context_id, 0, reliable, source });
+  }
+
+  /**
+   * @brief Forgets the streams of context_id, and those of other
+   *        connections for objects forwarded from context_id.
+   *
+   * @returns Connection and stream of each stream for objects forwarded from
+   *          context_id, which stay open until closed.
+   */
+  std::vector<std::pair<qtransport::TransportContextId, qtransport::StreamId>>
+  erase(const qtransport::TransportContextId& context_id)
+  {
+    std::vector<std::pair<qtransport::TransportContextId, qtransport::StreamId>>
+      forwarded;
+
+    const auto lock = _streams.lock();
+    auto streams = std::make_shared<Streams>(_streams.get());
+    const auto removed = std::erase_if(*streams, [&](const auto& entry) {
+      const auto& [key, stream_id] = entry;
+      if (key.context_id == context_id)
+        return true;
+
+      if (!key.source || key.source->first != context_id)
+        return false;
+
+      forwarded.emplace_back(key.context_id, stream_id);
+      return true;
+    });
+
+    if (removed)
+      _streams.store(std::move(streams));
+
+    return forwarded;
+  }
+
+  size_t size() const { return _streams.load()->size(); }
+
+private:
+  struct Key
+  {
+    qtransport::TransportContextId context_id;
+    uint8_t priority;
+    bool reliable;
+
+    // Connection and stream forwarded objects were received on, if any
+    std::optional<
+      std::pair<qtransport::TransportContextId, qtransport::StreamId>>
+      source;
+
+    bool operator==(const Key&) const = default;
+  };
+
+  struct KeyHash
+  {
+    size_t operator()(const Key& key) const
+    {
+      auto hash = key.context_id * 0x9E3779B97F4A7C15 ^ key.priority << 1 ^
+                  key.reliable;
+      if (key.source) {
+        hash ^= key.source->first * 0xC2B2AE3D27D4EB4F ^
+                key.source->second * 0x165667B19E3779F9 ^ 0x100;
+      }
+
+      return std::hash<uint64_t>{}(hash);
+    }
+  };
+
+  using Streams = std::unordered_map<Key, qtransport::StreamId, KeyHash>;
+
+  qtransport::StreamId get(qtransport::ITransport& transport, const Key& key)
+  {
+    if (const auto stream_id = find(*_streams.load(), key))
+      return *stream_id;
+
+    const auto lock = _streams.lock();
+    if (const auto stream_id = find(_streams.get(), key))
+      return *stream_id;
+
+    const auto stream_id = transport.createStream(key.context_id, key.reliable);
+    auto streams = std::make_shared<Streams>(_streams.get());
+    streams->emplace(key, stream_id);
+    _streams.store(std::move(streams));
+
+    return stream_id;
+  }
+
+  static std::optional<qtransport::StreamId> find(const Streams& streams,
+                                                  const Key& key)
+  {
+    const auto it = streams.find(key);
+    if (it == streams.end())
+      return std::nullopt;
+
+    return it->second;
+  }
+
+  Snapshot<Streams> _streams;
+};
+
+}
@@ -0,0 +1,237 @@
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <string>
+
+namespace quicr {
+/**
+ * @brief Variable length integer
+ */
+class uintVar_t
+{
+public:
+  uintVar_t() = default;
+  constexpr uintVar_t(const uintVar_t&) = default;
+  constexpr uintVar_t(uintVar_t&&) = default;
+  constexpr uintVar_t(uint64_t value)
+    : _value{ value }
+  {
+    if (value >= 0x1ull << 61)
+      throw std::runtime_error("Max value cannot be exceeded: " +
+                               std::to_string(0x1ull << 61));
+  }
+
+  constexpr operator uint64_t() const { return _value; }
+  constexpr uintVar_t& operator=(const uintVar_t&) = default;
+  constexpr uintVar_t& operator=(uintVar_t&&) = default;
+  constexpr uintVar_t& operator=(uint64_t value)
+  {
+    if (value >= 0x1ull << 61)
+      throw std::runtime_error("Max value cannot be exceeded: " +
+                               std::to_string(0x1ull << 61));
+    _value = value;
+    return *this;
+  }
+
+  constexpr bool operator==(uintVar_t other) { return _value == other._value; }
+  constexpr bool operator!=(uintVar_t other) { return !(*this == other); }
+  constexpr bool operator>(uintVar_t other) { return _value > other._value; }
+  constexpr bool operator>=(uintVar_t other) { return _value >= other._value; }
+  constexpr bool operator<(uintVar_t other) { return _value < other._value; }
+  constexpr bool operator<=(uintVar_t other) { return _value <= other._value; }
+
+  friend std::ostream& operator<<(std::ostream& os, uintVar_t v)
+  {
+    return os << v._value;
+  }
+
+private:
+  uint64_t _value;
+};
+
+// clang-format off
+/**
+ * @brief Converts between host and network (big endian) byte order.
+ */
+constexpr uint16_t
+swap_bytes(uint16_t value)
+{
+  if constexpr (std::endian::native == std::endian::big)
+    return value;
+
+  return ((value >> 8) & 0x00ff) | ((value << 8) & 0xff00);
+}
+
+constexpr uint32_t
+swap_bytes(uint32_t value)
+{
+  if constexpr (std::endian::native == std::endian::big)
+    return value;
+
+  return ((value >> 24) & 0x000000ff) |
+         ((value >>  8) & 0x0000ff00) |
+         ((value <<  8) & 0x00ff0000) |
+         ((value << 24) & 0xff000000);
+}
+
+constexpr uint64_t
+swap_bytes(uint64_t value)
+{
+  if constexpr (std::endian::native == std::endian::big)
+    return value;
+
+  return ((value >> 56) & 0x00000000000000ff) |
+         ((value >> 40) & 0x000000000000ff00) |
+         ((value >> 24) & 0x0000000000ff0000) |
+         ((value >>  8) & 0x00000000ff000000) |
+         ((value <<  8) & 0x000000ff00000000) |
+         ((value << 24) & 0x0000ff0000000000) |
+         ((value << 40) & 0x00ff000000000000) |
+         ((value << 56) & 0xff00000000000000);
+}
+// clang-format on
+
+/**
+ * @brief Codec for the uintVar_t wire format.
+ *
+ * @details A value is encoded in 1, 2, 4 or 8 bytes in network byte order.
+ *          The number of leading one bits in the first byte gives the length:
+ *
+ *              0xxxxxxx                                 7 bit value
+ *              10xxxxxx xxxxxxxx                       14 bit value
+ *              110xxxxx xxxxxxxx{2}                    29 bit value
+ *              1110xxxx xxxxxxxx{7}                    60 bit value
+ *
+ *          Each form is written and read with a single load or store plus a
+ *          byte swap, rather than one byte at a time.
+ */
+namespace varint {
+
+/**
+ * Largest number of bytes a single encoded value can take.
+ */
+constexpr size_t max_size = 8;
+
+/**
+ * @brief Number of bytes value takes once encoded.
+ */
+constexpr size_t
+size(uint64_t value)
+{
+  if (value < (uint64_t(1) << 7))
+    return 1;
+  if (value < (uint64_t(1) << 14))
+    return 2;
+  if (value < (uint64_t(1) << 29))
+    return 4;
+  return 8;
+}
+
+/**
+ * @brief Total number of bytes values take once encoded back to back.
+ */
+constexpr size_t
+size(std::span<const uintVar_t> values)
+{
+  size_t total = 0;
+  for (const auto& value : values)
+    total += size(value);
+  return total;
+}
+
+/**
+ * @brief Length of an encoded value, read from its first byte.
+ */
+constexpr size_t
+length(uint8_t first_byte)
+{
+  if (first_byte < 0x80)
+    return 1;
+  if (first_byte < 0xC0)
+    return 2;
+  if (first_byte < 0xE0)
+    return 4;
+  return 8;
+}
+
+/**
+ * @brief Encodes value into out, which must have room for max_size bytes.
+ *
+ * @returns The number of bytes written.
+ */
+inline size_t
+encode(uint64_t value, uint8_t* out)
+{
+  if (value < (uint64_t(1) << 7)) {
+    *out = static_cast<uint8_t>(value);
+    return 1;
+  }
+
+  if (value < (uint64_t(1) << 14)) {
+    const uint16_t bytes = swap_bytes(static_cast<uint16_t>(value | 0x8000));
+    std::memcpy(out, &bytes, sizeof(bytes));
+    return sizeof(bytes);
+  }
+
+  if (value < (uint64_t(1) << 29)) {
+    const uint32_t bytes =
+      swap_bytes(static_cast<uint32_t>(value) | uint32_t(0xC0000000));
+    std::memcpy(out, &bytes, sizeof(bytes));
+    return sizeof(bytes);
+  }
+
+  const uint64_t bytes = swap_bytes(
+    static_cast<uint64_t>((value & 0x0FFFFFFFFFFFFFFF) | 0xE000000000000000));
+  std::memcpy(out, &bytes, sizeof(bytes));
+  return sizeof(bytes);
+}
+
+/**
+ * @brief Encodes values back to back into out in one pass. out must have room
+ *        for size(values) bytes.
+ *
+ * @returns The number of bytes written.
+ */
+inline size_t
+encode(std::span<const uintVar_t> values, uint8_t* out)
+{
+  uint8_t* it = out;
+  for (const auto& value : values)
+    it += encode(value, it);
+  return it - out;
+}
+
+/**
+ * @brief Decodes a value of the given length, as returned by length(in[0]).
+ *        in must hold at least that many bytes.
+ */
+inline uint64_t
+decode(const uint8_t* in, size_t length)
+{
+  if (length == 1)
+    return in[0];
+
+  if (length == 2) {
+    uint16_t bytes;
+    std::memcpy(&bytes, in, sizeof(bytes));
+    return swap_bytes(bytes) & 0x3FFF;
+  }
+
+  if (length == 4) {
+    uint32_t bytes;
+    std::memcpy(&bytes, in, sizeof(bytes));
+    return swap_bytes(bytes) & 0x1FFFFFFF;
+  }
+
+  uint64_t bytes;
+  std::memcpy(&bytes, in, sizeof(bytes));
+  return swap_bytes(bytes) & 0x0FFFFFFFFFFFFFFF;
+}
+
+} // namespace varint
+}
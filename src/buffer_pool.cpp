@@ -0,0 +1,50 @@
+#include <quicr/buffer_pool.h>
+
+namespace quicr::messages {
+
+BufferPool::BufferPool()
+  : _free{ MPMCQueue<std::vector<uint8_t>>{ size_classes[0].max_buffers },
+           MPMCQueue<std::vector<uint8_t>>{ size_classes[1].max_buffers },
+           MPMCQueue<std::vector<uint8_t>>{ size_classes[2].max_buffers } }
+{
+}
+
+std::vector<uint8_t>
+BufferPool::acquire(size_t size)
+{
+  std::vector<uint8_t> buffer;
+
+  for (size_t i = 0; i < size_classes.size(); ++i) {
+    if (size > size_classes[i].buffer_size)
+      continue;
+
+    if (!_free[i].try_pop(buffer)) {
+      buffer.reserve(size_classes[i].buffer_size);
+    }
+
+    return buffer;
+  }
+
+  buffer.reserve(size);
+  return buffer;
+}
+
+void
+BufferPool::release(std::vector<uint8_t>&& buffer)
+{
+  // File the buffer under the largest class it can hold. Buffers that are
+  // much larger than their class are dropped rather than pinning memory.
+  for (size_t i = size_classes.size(); i-- > 0;) {
+    const auto buffer_size = size_classes[i].buffer_size;
+    if (buffer.capacity() < buffer_size)
+      continue;
+
+    if (buffer.capacity() <= 2 * buffer_size) {
+      buffer.clear();
+      _free[i].try_push(std::move(buffer));
+    }
+    return;
+  }
+}
+
+}
@@ -1,4 +1,3 @@
-#include <array>
 #include <ctime>
 #include <string>
 
@@ -22,119 +21,101 @@ create_transaction_id()
 MessageBuffer&
 operator<<(MessageBuffer& buffer, const Subscribe& msg)
 {
-  buffer << static_cast<uint8_t>(MessageType::Subscribe);
-  buffer << msg.transaction_id;
-  buffer << msg.quicr_namespace;
-  buffer << static_cast<uint8_t>(msg.intent);
+  return layout::encode(buffer, msg);
+}
+
+DecodeStatus
+try_decode(MessageBufferView& buffer, Subscribe& msg)
+{
+  return layout::decode(buffer, msg);
+}
 
+MessageBufferView&
+operator>>(MessageBufferView& buffer, Subscribe& msg)
+{
+  throw_on_error(try_decode(buffer, msg), "Subscribe");
   return buffer;
 }
 
 MessageBuffer&
 operator>>(MessageBuffer& buffer, Subscribe& msg)
 {
-  uint8_t msg_type;
-  buffer >> msg_type;
-  if (msg_type != static_cast<uint8_t>(MessageType::Subscribe)) {
-    throw MessageBuffer::MessageTypeException(
-      "Message type for Subscribe object must "
-      "be MessageType::Subscribe");
-  }
-
-  buffer >> msg.transaction_id;
-  buffer >> msg.quicr_namespace;
-  uint8_t intent = 0;
-  buffer >> intent;
-  msg.intent = static_cast<SubscribeIntent>(intent);
-
-  return buffer;
+  return read_from_view(buffer, msg);
 }
 
 MessageBuffer&
 operator<<(MessageBuffer& buffer, const Unsubscribe& msg)
 {
-  buffer << static_cast<uint8_t>(MessageType::Unsubscribe);
-  buffer << msg.quicr_namespace;
+  return layout::encode(buffer, msg);
+}
+
+DecodeStatus
+try_decode(MessageBufferView& buffer, Unsubscribe& msg)
+{
+  return layout::decode(buffer, msg);
+}
 
+MessageBufferView&
+operator>>(MessageBufferView& buffer, Unsubscribe& msg)
+{
+  throw_on_error(try_decode(buffer, msg), "Unsubscribe");
   return buffer;
 }
 
 MessageBuffer&
 operator>>(MessageBuffer& buffer, Unsubscribe& msg)
 {
-  uint8_t msg_type;
-  buffer >> msg_type;
-  if (msg_type != static_cast<uint8_t>(MessageType::Unsubscribe)) {
-    throw MessageBuffer::MessageTypeException(
-      "Message type for Unsubscribe object "
-      "must be MessageType::Unsubscribe");
-  }
-
-  buffer >> msg.quicr_namespace;
-
-  return buffer;
+  return read_from_view(buffer, msg);
 }
 
 MessageBuffer&
 operator<<(MessageBuffer& buffer, const SubscribeResponse& msg)
 {
-  buffer << static_cast<uint8_t>(MessageType::SubscribeResponse);
-  buffer << static_cast<uint8_t>(msg.response);
-  buffer << msg.transaction_id;
-  buffer << msg.quicr_namespace;
+  return layout::encode(buffer, msg);
+}
 
+DecodeStatus
+try_decode(MessageBufferView& buffer, SubscribeResponse& msg)
+{
+  return layout::decode(buffer, msg);
+}
+
+MessageBufferView&
+operator>>(MessageBufferView& buffer, SubscribeResponse& msg)
+{
+  throw_on_error(try_decode(buffer, msg), "SubscribeResponse");
   return buffer;
 }
 
 MessageBuffer&
 operator>>(MessageBuffer& buffer, SubscribeResponse& msg)
 {
-  uint8_t msg_type;
-  buffer >> msg_type;
-  if (msg_type != static_cast<uint8_t>(MessageType::SubscribeResponse)) {
-    throw MessageBuffer::MessageTypeException(
-      "Message type for SubscribeResponse object "
-      "must be MessageType::SubscribeResponse");
-  }
-
-  uint8_t response;
-  buffer >> response;
-  msg.response = static_cast<SubscribeResult::SubscribeStatus>(response);
-
-  buffer >> msg.transaction_id;
-  buffer >> msg.quicr_namespace;
-
-  return buffer;
+  return read_from_view(buffer, msg);
 }
 
 MessageBuffer&
 operator<<(MessageBuffer& buffer, const SubscribeEnd& msg)
 {
-  buffer << static_cast<uint8_t>(MessageType::SubscribeEnd);
-  buffer << static_cast<uint8_t>(msg.reason);
-  buffer << msg.quicr_namespace;
+  return layout::encode(buffer, msg);
+}
+
+DecodeStatus
+try_decode(MessageBufferView& buffer, SubscribeEnd& msg)
+{
+  return layout::decode(buffer, msg);
+}
 
+MessageBufferView&
+operator>>(MessageBufferView& buffer, SubscribeEnd& msg)
+{
+  throw_on_error(try_decode(buffer, msg), "SubscribeEnd");
   return buffer;
 }
 
 MessageBuffer&
 operator>>(MessageBuffer& buffer, SubscribeEnd& msg)
 {
-  uint8_t msg_type;
-  buffer >> msg_type;
-  if (msg_type != static_cast<uint8_t>(MessageType::SubscribeEnd)) {
-    throw MessageBuffer::MessageTypeException(
-      "Message type for SubscribeEnd object "
-      "must be MessageType::SubscribeEnd");
-  }
-
-  uint8_t reason;
-  buffer >> reason;
-  msg.reason = static_cast<SubscribeResult::SubscribeStatus>(reason);
-
-  buffer >> msg.quicr_namespace;
-
-  return buffer;
+  return read_from_view(buffer, msg);
 }
 
 /*===========================================================================*/
@@ -144,248 +125,461 @@ operator>>(MessageBuffer& buffer, SubscribeEnd& msg)
 MessageBuffer&
 operator<<(MessageBuffer& buffer, const PublishIntent& msg)
 {
-  buffer << static_cast<uint8_t>(msg.message_type);
-  buffer << msg.transaction_id;
-  buffer << msg.quicr_namespace;
-  buffer << msg.payload;
-  buffer << msg.media_id;
-  buffer << msg.datagram_capable;
-  return buffer;
+  return layout::encode(buffer, msg);
 }
 
 MessageBuffer&
 operator<<(MessageBuffer& buffer, PublishIntent&& msg)
 {
-  buffer << static_cast<uint8_t>(msg.message_type);
-  buffer << msg.transaction_id;
-  buffer << msg.quicr_namespace;
-  buffer << std::move(msg.payload);
-  buffer << msg.media_id;
-  buffer << msg.datagram_capable;
+  // Bytes are copied either way, so there is nothing to gain from moving
+  return buffer << static_cast<const PublishIntent&>(msg);
+}
+
+DecodeStatus
+try_decode(MessageBufferView& buffer, PublishIntent& msg)
+{
+  return layout::decode(buffer, msg);
+}
+
+MessageBufferView&
+operator>>(MessageBufferView& buffer, PublishIntent& msg)
+{
+  throw_on_error(try_decode(buffer, msg), "PublishIntent");
   return buffer;
 }
 
 MessageBuffer&
 operator>>(MessageBuffer& buffer, PublishIntent& msg)
 {
-  uint8_t msg_type;
-  buffer >> msg_type;
-  msg.message_type = static_cast<MessageType>(msg_type);
-
-  buffer >> msg.transaction_id;
-  buffer >> msg.quicr_namespace;
-  buffer >> msg.payload;
-  buffer >> msg.media_id;
-  buffer >> msg.datagram_capable;
-
-  return buffer;
+  return read_from_view(buffer, msg);
 }
 
 MessageBuffer&
 operator<<(MessageBuffer& buffer, const PublishIntentResponse& msg)
 {
-  buffer << static_cast<uint8_t>(msg.message_type);
-  buffer << msg.quicr_namespace;
-  buffer << static_cast<uint8_t>(msg.response);
-  buffer << msg.transaction_id;
+  return layout::encode(buffer, msg);
+}
+
+DecodeStatus
+try_decode(MessageBufferView& buffer, PublishIntentResponse& msg)
+{
+  return layout::decode(buffer, msg);
+}
 
+MessageBufferView&
+operator>>(MessageBufferView& buffer, PublishIntentResponse& msg)
+{
+  throw_on_error(try_decode(buffer, msg), "PublishIntentResponse");
   return buffer;
 }
 
 MessageBuffer&
 operator>>(MessageBuffer& buffer, PublishIntentResponse& msg)
 {
-  uint8_t msg_type;
-  buffer >> msg_type;
-  msg.message_type = static_cast<MessageType>(msg_type);
-
-  buffer >> msg.quicr_namespace;
-
-  uint8_t response;
-  buffer >> response;
-  msg.response = static_cast<Response>(response);
-
-  buffer >> msg.transaction_id;
-
-  return buffer;
+  return read_from_view(buffer, msg);
 }
 
 MessageBuffer&
 operator<<(MessageBuffer& buffer, const Header& msg)
 {
-  buffer << msg.name;
-  buffer << msg.media_id;
-  buffer << msg.group_id;
-  buffer << msg.object_id;
-  buffer << msg.offset_and_fin;
-  buffer << msg.flags;
+  return layout::encode(buffer, msg);
+}
+
+DecodeStatus
+try_decode(MessageBufferView& buffer, Header& msg)
+{
+  return layout::decode(buffer, msg);
+}
 
+MessageBufferView&
+operator>>(MessageBufferView& buffer, Header& msg)
+{
+  throw_on_error(try_decode(buffer, msg), "Header");
   return buffer;
 }
 
 MessageBuffer&
 operator>>(MessageBuffer& buffer, Header& msg)
 {
-  buffer >> msg.name;
-  buffer >> msg.media_id;
-  buffer >> msg.group_id;
-  buffer >> msg.object_id;
-  buffer >> msg.offset_and_fin;
-  buffer >> msg.flags;
-
-  return buffer;
+  return read_from_view(buffer, msg);
 }
 
 MessageBuffer&
 operator<<(MessageBuffer& buffer, const PublishDatagram& msg)
 {
-  buffer << static_cast<uint8_t>(MessageType::Publish);
-  buffer << msg.header;
-  buffer << static_cast<uint8_t>(msg.media_type);
-  buffer << msg.media_data_length;
-  buffer << msg.media_data;
-
-  return buffer;
+  return layout::encode(buffer, msg);
 }
 
 MessageBuffer&
 operator<<(MessageBuffer& buffer, PublishDatagram&& msg)
 {
-  buffer << static_cast<uint8_t>(MessageType::Publish);
-  buffer << std::move(msg.header);
-  buffer << static_cast<uint8_t>(msg.media_type);
-  buffer << msg.media_data_length;
-  buffer << std::move(msg.media_data);
+  // Bytes are copied either way, so there is nothing to gain from moving
+  return buffer << static_cast<const PublishDatagram&>(msg);
+}
+
+MessageBuffer&
+operator<<(MessageBuffer& buffer, const PublishDatagramView& msg)
+{
+  return layout::encode(buffer, msg);
+}
+
+std::vector<uint8_t>
+PublishDatagramSegments::gather() &&
+{
+  header.push(payload);
+  payload = {};
+  return header.get();
+}
+
+namespace {
+// Encodes a Publish datagram up to, and including, the payload length
+void
+encode_publish_header(MessageBuffer& buffer, const PublishDatagramView& msg)
+{
+  const size_t payload_size = msg.media_data.size();
+
+  auto out = buffer.extend(wire_size(msg) - payload_size).data();
+  out = layout::Codec<MessageType>::write(out, MessageType::Publish);
+  out = layout::Codec<Header>::write(out, msg.header);
+  out = layout::Codec<MediaType>::write(out, msg.media_type);
+  out = layout::Codec<uintVar_t>::write(out, msg.media_data_length);
+  layout::Codec<uintVar_t>::write(out, payload_size);
+}
+
+PublishDatagramSegments
+encode_segments(const PublishDatagramView& msg, MessageBuffer&& header)
+{
+  PublishDatagramSegments segments{ std::move(header), msg.media_data };
+  encode_publish_header(segments.header, msg);
+
+  return segments;
+}
+}
+
+PublishDatagramSegments
+encode_segments(const PublishDatagramView& msg)
+{
+  return encode_segments(msg, MessageBuffer{ wire_size(msg) });
+}
+
+PublishDatagramSegments
+encode_segments(const PublishDatagramView& msg, BufferPool& pool)
+{
+  return encode_segments(msg, MessageBuffer{ wire_size(msg), pool });
+}
 
+DecodeStatus
+try_decode(MessageBufferView& buffer, PublishDatagramView& msg)
+{
+  return layout::decode(buffer, msg);
+}
+
+MessageBufferView&
+operator>>(MessageBufferView& buffer, PublishDatagramView& msg)
+{
+  throw_on_error(try_decode(buffer, msg), "PublishDatagram");
   return buffer;
 }
 
-MessageBuffer&
-operator>>(MessageBuffer& buffer, PublishDatagram& msg)
+DecodeStatus
+try_peek_publish_header(std::span<const uint8_t> packet, Header& header)
 {
-  uint8_t msg_type;
-  buffer >> msg_type;
-  if (msg_type != static_cast<uint8_t>(MessageType::Publish)) {
-    throw MessageBuffer::MessageTypeException(
-      "Message type for PublishDatagram object must be MessageType::Publish");
-  }
+  MessageBufferView buffer{ packet };
 
-  buffer >> msg.header;
+  uint8_t msg_type;
+  if (auto status = try_decode(buffer, msg_type); status != DecodeStatus::Ok)
+    return status;
+  if (msg_type != static_cast<uint8_t>(MessageType::Publish))
+    return DecodeStatus::InvalidType;
 
-  uint8_t media_type;
-  buffer >> media_type;
-  msg.media_type = static_cast<MediaType>(media_type);
+  return try_decode(buffer, header);
+}
 
-  buffer >> msg.media_data_length;
-  buffer >> msg.media_data;
+Header
+peek_publish_header(std::span<const uint8_t> packet)
+{
+  Header header;
+  throw_on_error(try_peek_publish_header(packet, header), "PublishDatagram");
+  return header;
+}
 
-  if (msg.media_data.size() != static_cast<size_t>(msg.media_data_length)) {
-    throw MessageBuffer::LengthException(
-      "PublishDatagram size of decoded media data must match decoded length");
-  }
+DecodeStatus
+try_decode(MessageBufferView& buffer, PublishDatagram& msg)
+{
+  return layout::decode(buffer, msg);
+}
 
+MessageBufferView&
+operator>>(MessageBufferView& buffer, PublishDatagram& msg)
+{
+  throw_on_error(try_decode(buffer, msg), "PublishDatagram");
   return buffer;
 }
 
+MessageBuffer&
+operator>>(MessageBuffer& buffer, PublishDatagram& msg)
+{
+  return read_from_view(buffer, msg);
+}
+
 MessageBuffer&
 operator<<(MessageBuffer& buffer, const PublishStream& msg)
 {
-  buffer << msg.media_data_length;
-  buffer << msg.media_data;
-  return buffer;
+  return layout::encode(buffer, msg);
 }
 
 MessageBuffer&
 operator<<(MessageBuffer& buffer, PublishStream&& msg)
 {
-  buffer << msg.media_data_length;
-  buffer << std::move(msg.media_data);
+  // Bytes are copied either way, so there is nothing to gain from moving
+  return buffer << static_cast<const PublishStream&>(msg);
+}
+
+DecodeStatus
+try_decode(MessageBufferView& buffer, PublishStream& msg)
+{
+  return layout::decode(buffer, msg);
+}
+
+MessageBufferView&
+operator>>(MessageBufferView& buffer, PublishStream& msg)
+{
+  throw_on_error(try_decode(buffer, msg), "PublishStream");
   return buffer;
 }
 
 MessageBuffer&
 operator>>(MessageBuffer& buffer, PublishStream& msg)
 {
-  buffer >> msg.media_data_length;
-  buffer >> msg.media_data;
-  if (msg.media_data.size() != static_cast<size_t>(msg.media_data_length)) {
-    throw MessageBuffer::LengthException(
-      "PublishStream size of decoded media data must match decoded length");
-  }
-
-  return buffer;
+  return read_from_view(buffer, msg);
 }
 
 MessageBuffer&
 operator<<(MessageBuffer& buffer, const PublishIntentEnd& msg)
 {
-  buffer << static_cast<uint8_t>(msg.message_type);
-  buffer << msg.quicr_namespace;
-  buffer << msg.payload;
-
-  return buffer;
+  return layout::encode(buffer, msg);
 }
 
 MessageBuffer&
 operator<<(MessageBuffer& buffer, PublishIntentEnd&& msg)
 {
-  buffer << static_cast<uint8_t>(msg.message_type);
-  buffer << msg.quicr_namespace;
-  buffer << std::move(msg.payload);
+  // Bytes are copied either way, so there is nothing to gain from moving
+  return buffer << static_cast<const PublishIntentEnd&>(msg);
+}
 
+DecodeStatus
+try_decode(MessageBufferView& buffer, PublishIntentEnd& msg)
+{
+  return layout::decode(buffer, msg);
+}
+
+MessageBufferView&
+operator>>(MessageBufferView& buffer, PublishIntentEnd& msg)
+{
+  throw_on_error(try_decode(buffer, msg), "PublishIntentEnd");
   return buffer;
 }
 
 MessageBuffer&
 operator>>(MessageBuffer& buffer, PublishIntentEnd& msg)
 {
-  uint8_t msg_type;
-  buffer >> msg_type;
-  msg.message_type = static_cast<MessageType>(msg_type);
+  return read_from_view(buffer, msg);
+}
 
-  buffer >> msg.quicr_namespace;
-  buffer >> msg.payload;
+/*===========================================================================*/
+// Batch Framing
+/*===========================================================================*/
 
-  return buffer;
+MessageBatch::MessageBatch(size_t max_size)
+  : _max_size{ max_size }
+{
+}
+
+size_t
+MessageBatch::size() const
+{
+  if (empty())
+    return 0;
+
+  return sizeof(MessageType) + varint::size(_buffer.size()) + _buffer.size();
+}
+
+bool
+MessageBatch::fits(size_t message_size) const
+{
+  const size_t body_size = (empty() ? 0 : _buffer.size()) +
+                           varint::size(message_size) + message_size;
+  return sizeof(MessageType) + varint::size(body_size) + body_size <=
+         _max_size;
+}
+
+void
+MessageBatch::append(std::span<const uint8_t> message)
+{
+  if (empty()) {
+    _buffer = MessageBuffer{ _max_size };
+  }
+
+  _buffer << static_cast<uintVar_t>(message.size());
+  _buffer.push(message);
+  ++_count;
+}
+
+std::vector<uint8_t>
+MessageBatch::encode() const
+{
+  MessageBuffer batch{ size() };
+  batch << static_cast<uint8_t>(MessageType::Batch)
+        << static_cast<uintVar_t>(_buffer.size());
+  batch.push(_buffer.view().data());
+  return batch.get();
+}
+
+void
+MessageBatch::clear()
+{
+  _buffer = MessageBuffer{};
+  _count = 0;
+}
+
+std::vector<uint8_t>
+MessageBatch::flush()
+{
+  auto batch = encode();
+  clear();
+  return batch;
 }
 
 messages::MessageBuffer&
 operator<<(messages::MessageBuffer& msg, const quicr::Name& val)
 {
-  for (int i = sizeof(quicr::Name) - 1; i >= 0; --i)
-    msg << val[i];
+  return layout::encode(msg, val);
+}
+
+DecodeStatus
+try_decode(MessageBufferView& msg, quicr::Name& val)
+{
+  return layout::decode(msg, val);
+}
 
+messages::MessageBufferView&
+operator>>(messages::MessageBufferView& msg, quicr::Name& val)
+{
+  throw_on_error(try_decode(msg, val), "Name");
   return msg;
 }
 
 messages::MessageBuffer&
 operator>>(messages::MessageBuffer& msg, quicr::Name& val)
 {
-  std::array<uint8_t, sizeof(quicr::Name)> bytes;
-  for (int i = sizeof(quicr::Name) - 1; i >= 0; --i)
-    msg >> bytes[i];
-
-  val = Name{ bytes.data(), sizeof(quicr::Name) };
-
-  return msg;
+  return read_from_view(msg, val);
 }
 
 messages::MessageBuffer&
 operator<<(messages::MessageBuffer& msg, const quicr::Namespace& val)
 {
-  msg << val.name() << val.length();
+  return layout::encode(msg, val);
+}
+
+DecodeStatus
+try_decode(MessageBufferView& msg, quicr::Namespace& val)
+{
+  return layout::decode(msg, val);
+}
+
+messages::MessageBufferView&
+operator>>(messages::MessageBufferView& msg, quicr::Namespace& val)
+{
+  throw_on_error(try_decode(msg, val), "Namespace");
   return msg;
 }
 
 messages::MessageBuffer&
 operator>>(messages::MessageBuffer& msg, quicr::Namespace& val)
 {
-  quicr::Name name_mask;
-  uint8_t sig_bits;
-  msg >> name_mask >> sig_bits;
-  val = Namespace{ name_mask, sig_bits };
+  return read_from_view(msg, val);
+}
 
-  return msg;
+/*===========================================================================*/
+// Wire Size
+/*===========================================================================*/
+
+size_t
+wire_size(const Name& name)
+{
+  return layout::Codec<Name>::size(name);
+}
+
+size_t
+wire_size(const Namespace& ns)
+{
+  return layout::Codec<Namespace>::size(ns);
+}
+
+size_t
+wire_size(const Subscribe& msg)
+{
+  return layout::wire_size(msg);
+}
+
+size_t
+wire_size(const Unsubscribe& msg)
+{
+  return layout::wire_size(msg);
+}
+
+size_t
+wire_size(const SubscribeResponse& msg)
+{
+  return layout::wire_size(msg);
+}
+
+size_t
+wire_size(const SubscribeEnd& msg)
+{
+  return layout::wire_size(msg);
+}
+
+size_t
+wire_size(const PublishIntent& msg)
+{
+  return layout::wire_size(msg);
+}
+
+size_t
+wire_size(const PublishIntentResponse& msg)
+{
+  return layout::wire_size(msg);
+}
+
+size_t
+wire_size(const Header& msg)
+{
+  return layout::wire_size(msg);
+}
+
+size_t
+wire_size(const PublishDatagram& msg)
+{
+  return layout::wire_size(msg);
+}
+
+size_t
+wire_size(const PublishDatagramView& msg)
+{
+  return layout::wire_size(msg);
+}
+
+size_t
+wire_size(const PublishStream& msg)
+{
+  return layout::wire_size(msg);
+}
+
+size_t
+wire_size(const PublishIntentEnd& msg)
+{
+  return layout::wire_size(msg);
 }
 
 }
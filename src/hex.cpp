@@ -0,0 +1,201 @@
+#include <quicr/hex.h>
+#include <quicr/varint.h>
+
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define QUICR_HEX_SSE2 1
+#endif
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define QUICR_HEX_AVX2 1
+#endif
+
+namespace quicr::hex {
+
+namespace {
+constexpr char digits[] = "0123456789ABCDEF";
+
+// Value of a hex digit, or -1 if c is not one
+constexpr int
+digit_value(char c)
+{
+  if ('0' <= c && c <= '9')
+    return c - '0';
+  if ('A' <= c && c <= 'F')
+    return c - 'A' + 10;
+  if ('a' <= c && c <= 'f')
+    return c - 'a' + 10;
+  return -1;
+}
+
+// Network order bytes of the 128 bit value hi:low
+void
+to_bytes(uint64_t hi, uint64_t low, uint8_t* bytes)
+{
+  hi = swap_bytes(hi);
+  low = swap_bytes(low);
+  std::memcpy(bytes, &hi, sizeof(hi));
+  std::memcpy(bytes + sizeof(hi), &low, sizeof(low));
+}
+
+[[maybe_unused]] void
+encode_scalar(const uint8_t* bytes, size_t size, char* out)
+{
+  for (size_t i = 0; i < size; ++i) {
+    *out++ = digits[bytes[i] >> 4];
+    *out++ = digits[bytes[i] & 0x0F];
+  }
+}
+
+[[maybe_unused]] bool
+decode_scalar(const char* in, size_t size, uint8_t* bytes)
+{
+  for (size_t i = 0; i < size; ++i) {
+    const int high = digit_value(in[2 * i]);
+    const int low = digit_value(in[2 * i + 1]);
+    if (high < 0 || low < 0)
+      return false;
+
+    bytes[i] = static_cast<uint8_t>((high << 4) | low);
+  }
+
+  return true;
+}
+
+#ifdef QUICR_HEX_SSE2
+// Maps nibbles 0-15 to their upper case digits
+__m128i
+to_digits(__m128i nibbles)
+{
+  const __m128i letters =
+    _mm_and_si128(_mm_cmpgt_epi8(nibbles, _mm_set1_epi8(9)),
+                  _mm_set1_epi8('A' - '0' - 10));
+  return _mm_add_epi8(_mm_add_epi8(nibbles, _mm_set1_epi8('0')), letters);
+}
+
+// Splits bytes into high and low nibbles
+void
+to_nibbles(__m128i bytes, __m128i& high, __m128i& low)
+{
+  const __m128i mask = _mm_set1_epi8(0x0F);
+  high = _mm_and_si128(_mm_srli_epi16(bytes, 4), mask);
+  low = _mm_and_si128(bytes, mask);
+}
+
+// Maps 16 hex digits to their values, returning false on any other character
+bool
+to_values(__m128i chars, __m128i& values)
+{
+  auto in_range = [](__m128i c, char first, char last) {
+    return _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8(first - 1)),
+                         _mm_cmplt_epi8(c, _mm_set1_epi8(last + 1)));
+  };
+
+  const __m128i lower = _mm_or_si128(chars, _mm_set1_epi8(0x20));
+  const __m128i is_digit = in_range(chars, '0', '9');
+  const __m128i is_letter = in_range(lower, 'a', 'f');
+
+  if (_mm_movemask_epi8(_mm_or_si128(is_digit, is_letter)) != 0xFFFF)
+    return false;
+
+  values = _mm_or_si128(
+    _mm_and_si128(is_digit, _mm_sub_epi8(chars, _mm_set1_epi8('0'))),
+    _mm_and_si128(is_letter, _mm_sub_epi8(lower, _mm_set1_epi8('a' - 10))));
+  return true;
+}
+
+// Joins each pair of digit values into a byte
+__m128i
+to_bytes(__m128i values)
+{
+  return _mm_or_si128(
+    _mm_slli_epi16(_mm_and_si128(values, _mm_set1_epi16(0x00FF)), 4),
+    _mm_srli_epi16(values, 8));
+}
+#endif
+}
+
+void
+encode(uint64_t value, char* out)
+{
+  value = swap_bytes(value);
+
+#ifdef QUICR_HEX_SSE2
+  __m128i high, low;
+  to_nibbles(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(&value)),
+             high,
+             low);
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(out),
+                   to_digits(_mm_unpacklo_epi8(high, low)));
+#else
+  uint8_t bytes[sizeof(value)];
+  std::memcpy(bytes, &value, sizeof(value));
+  encode_scalar(bytes, sizeof(bytes), out);
+#endif
+}
+
+void
+encode(uint64_t hi, uint64_t low, char* out)
+{
+  uint8_t bytes[2 * sizeof(uint64_t)];
+  to_bytes(hi, low, bytes);
+
+#if defined(QUICR_HEX_AVX2)
+  // Each 16 bit lane holds one byte as its high nibble then its low nibble
+  const __m256i words = _mm256_cvtepu8_epi16(
+    _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes)));
+  const __m256i nibbles = _mm256_or_si256(
+    _mm256_srli_epi16(words, 4),
+    _mm256_slli_epi16(_mm256_and_si256(words, _mm256_set1_epi16(0x0F)), 8));
+
+  const __m256i letters =
+    _mm256_and_si256(_mm256_cmpgt_epi8(nibbles, _mm256_set1_epi8(9)),
+                     _mm256_set1_epi8('A' - '0' - 10));
+  _mm256_storeu_si256(
+    reinterpret_cast<__m256i*>(out),
+    _mm256_add_epi8(_mm256_add_epi8(nibbles, _mm256_set1_epi8('0')), letters));
+#elif defined(QUICR_HEX_SSE2)
+  __m128i high, low_nibbles;
+  to_nibbles(_mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes)),
+             high,
+             low_nibbles);
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(out),
+                   to_digits(_mm_unpacklo_epi8(high, low_nibbles)));
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 16),
+                   to_digits(_mm_unpackhi_epi8(high, low_nibbles)));
+#else
+  encode_scalar(bytes, sizeof(bytes), out);
+#endif
+}
+
+bool
+decode(const char* in, uint64_t& hi, uint64_t& low)
+{
+  uint8_t bytes[2 * sizeof(uint64_t)];
+
+#ifdef QUICR_HEX_SSE2
+  __m128i first, second;
+  if (!to_values(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in)),
+                 first) ||
+      !to_values(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 16)),
+                 second))
+    return false;
+
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(bytes),
+                   _mm_packus_epi16(to_bytes(first), to_bytes(second)));
+#else
+  if (!decode_scalar(in, sizeof(bytes), bytes))
+    return false;
+#endif
+
+  std::memcpy(&hi, bytes, sizeof(hi));
+  std::memcpy(&low, bytes + sizeof(hi), sizeof(low));
+  hi = swap_bytes(hi);
+  low = swap_bytes(low);
+  return true;
+}
+
+}
@@ -1,10 +1,13 @@
+#include <quicr/buffer_pool.h>
 #include <quicr/message_buffer.h>
 
 #include <algorithm>
 #include <array>
 #include <bit>
+#include <cstring>
 #include <iomanip>
 #include <sstream>
+#include <utility>
 #include <vector>
 
 namespace quicr::messages {
@@ -18,6 +21,80 @@ MessageBuffer::MessageBuffer(std::vector<uint8_t>&& buffer)
 {
 }
 
+// Copies own plain storage, so only the original returns its buffer to a pool
+MessageBuffer::MessageBuffer(const MessageBuffer& other)
+  : _buffer{ other._buffer }
+  , _read_offset{ other._read_offset }
+{
+}
+
+// The moved-from buffer is left empty, rather than reading past its end
+MessageBuffer::MessageBuffer(MessageBuffer&& other)
+  : _buffer{ std::move(other._buffer) }
+  , _read_offset{ std::exchange(other._read_offset, 0) }
+  , _pool{ std::exchange(other._pool, nullptr) }
+{
+  other._buffer.clear();
+}
+
+MessageBuffer::MessageBuffer(size_t reserve_size, BufferPool& pool)
+  : _buffer{ pool.acquire(reserve_size) }
+  , _pool{ &pool }
+{
+}
+
+MessageBuffer::~MessageBuffer()
+{
+  if (_pool) {
+    _pool->release(std::move(_buffer));
+  }
+}
+
+MessageBuffer&
+MessageBuffer::operator=(const MessageBuffer& other)
+{
+  if (this == &other)
+    return *this;
+
+  if (_pool) {
+    _pool->release(std::move(_buffer));
+    _pool = nullptr;
+  }
+
+  _buffer = other._buffer;
+  _read_offset = other._read_offset;
+  return *this;
+}
+
+MessageBuffer&
+MessageBuffer::operator=(MessageBuffer&& other)
+{
+  if (this == &other)
+    return *this;
+
+  if (_pool) {
+    _pool->release(std::move(_buffer));
+  }
+
+  _buffer = std::move(other._buffer);
+  _read_offset = std::exchange(other._read_offset, 0);
+  _pool = std::exchange(other._pool, nullptr);
+  other._buffer.clear();
+  return *this;
+}
+
+void
+MessageBuffer::consume(size_t len)
+{
+  _read_offset += len;
+
+  // Once everything written has been read, reuse the storage from the start
+  if (_read_offset == _buffer.size()) {
+    _buffer.clear();
+    _read_offset = 0;
+  }
+}
+
 void
 MessageBuffer::pop()
 {
@@ -25,7 +102,7 @@ MessageBuffer::pop()
     throw MessageBuffer::ReadException("Cannot pop from empty message buffer");
   }
 
-  _buffer.erase(_buffer.begin());
+  consume(1);
 }
 
 void
@@ -34,6 +111,12 @@ MessageBuffer::push(const std::vector<uint8_t>& data)
   _buffer.insert(_buffer.end(), data.begin(), data.end());
 }
 
+void
+MessageBuffer::push(std::span<const uint8_t> data)
+{
+  _buffer.insert(_buffer.end(), data.begin(), data.end());
+}
+
 void
 MessageBuffer::push(std::vector<uint8_t>&& data)
 {
@@ -43,44 +126,43 @@ MessageBuffer::push(std::vector<uint8_t>&& data)
 }
 
 void
-MessageBuffer::pop(uint16_t len)
+MessageBuffer::pop(size_t len)
 {
   if (len == 0)
     return;
 
-  if (len > _buffer.size())
+  if (len > size())
     throw OutOfRangeException(
       "len cannot be longer than the size of the buffer");
 
-  _buffer.erase(_buffer.begin(), std::next(_buffer.begin(), len));
+  consume(len);
 };
 
 std::vector<uint8_t>
-MessageBuffer::front(uint16_t len)
+MessageBuffer::front(size_t len)
 {
   if (len == 0)
     return {};
 
-  if (len > _buffer.size())
+  if (len > size())
     throw OutOfRangeException(
       "len cannot be longer than the size of the buffer");
 
-  return { _buffer.begin(), std::next(_buffer.begin(), len) };
+  return { read_ptr(), read_ptr() + len };
 }
 
 std::vector<uint8_t>
-MessageBuffer::pop_front(uint16_t len)
+MessageBuffer::pop_front(size_t len)
 {
   if (len == 0)
     return {};
 
-  if (len > _buffer.size())
+  if (len > size())
     throw OutOfRangeException(
       "len cannot be longer than the size of the buffer");
 
-  std::vector<uint8_t> front(len);
-  std::copy_n(std::make_move_iterator(_buffer.begin()), len, front.begin());
-  _buffer.erase(_buffer.begin(), std::next(_buffer.begin(), len));
+  std::vector<uint8_t> front(read_ptr(), read_ptr() + len);
+  consume(len);
 
   return front;
 }
@@ -88,52 +170,70 @@ MessageBuffer::pop_front(uint16_t len)
 std::vector<uint8_t>
 MessageBuffer::get()
 {
+  if (_read_offset > 0) {
+    _buffer.erase(_buffer.begin(), std::next(_buffer.begin(), _read_offset));
+    _read_offset = 0;
+  }
+
   return std::move(_buffer);
 }
 
+MessageBufferView
+MessageBuffer::view() const
+{
+  return std::span<const uint8_t>{ read_ptr(), size() };
+}
+
 std::string
 MessageBuffer::to_hex() const
 {
   std::ostringstream hex;
   hex << std::hex << std::setfill('0');
-  for (const auto& byte : _buffer) {
-    hex << std::setw(2) << int(byte);
+  for (auto it = std::next(_buffer.begin(), _read_offset); it != _buffer.end();
+       ++it) {
+    hex << std::setw(2) << int(*it);
   }
   return hex.str();
 }
 
-// clang-format off
-constexpr uint16_t
-swap_bytes(uint16_t value)
+void
+MessageBufferView::pop()
+{
+  if (empty()) {
+    throw MessageBuffer::ReadException("Cannot pop from empty message buffer");
+  }
+
+  _data = _data.subspan(1);
+}
+
+void
+MessageBufferView::pop(size_t len)
 {
-  return ((value >> 8) & 0x00ff) | ((value << 8) & 0xff00);
+  if (len > size())
+    throw MessageBuffer::OutOfRangeException(
+      "len cannot be longer than the size of the buffer");
+
+  _data = _data.subspan(len);
 }
 
-constexpr uint32_t
-swap_bytes(uint32_t value)
+std::span<const uint8_t>
+MessageBufferView::front(size_t len) const
 {
-  return ((value >> 24) & 0x000000ff) |
-         ((value >>  8) & 0x0000ff00) |
-         ((value <<  8) & 0x00ff0000) |
-         ((value << 24) & 0xff000000);
+  if (len > size())
+    throw MessageBuffer::OutOfRangeException(
+      "len cannot be longer than the size of the buffer");
+
+  return _data.first(len);
 }
 
-constexpr uint64_t
-swap_bytes(uint64_t value)
+std::span<const uint8_t>
+MessageBufferView::pop_front(size_t len)
 {
-  if constexpr (std::endian::native == std::endian::big)
-    return value;
+  auto front_bytes = front(len);
+  _data = _data.subspan(len);
 
-  return ((value >> 56) & 0x00000000000000ff) |
-         ((value >> 40) & 0x000000000000ff00) |
-         ((value >> 24) & 0x0000000000ff0000) |
-         ((value >>  8) & 0x00000000ff000000) |
-         ((value <<  8) & 0x000000ff00000000) |
-         ((value << 24) & 0x0000ff0000000000) |
-         ((value << 40) & 0x00ff000000000000) |
-         ((value << 56) & 0xff00000000000000);
+  return front_bytes;
 }
-// clang-format on
 
 template<typename Uint_t>
 MessageBuffer&
@@ -159,34 +259,90 @@ operator<<(MessageBuffer& msg, uint8_t val)
   return msg;
 }
 
+void
+throw_on_error(DecodeStatus status, std::string_view type_name)
+{
+  switch (status) {
+    case DecodeStatus::Ok:
+      return;
+    case DecodeStatus::Truncated:
+      throw MessageBuffer::ReadException(
+        "Cannot decode " + std::string(type_name) +
+        ", buffer ended before the encoded value");
+    case DecodeStatus::InvalidType:
+      throw MessageBuffer::MessageTypeException(
+        "Message type for " + std::string(type_name) + " object is invalid");
+    case DecodeStatus::InvalidLength:
+      throw MessageBuffer::LengthException(
+        std::string(type_name) +
+        " size of decoded media data must match decoded length");
+  }
+}
+
 template<typename Uint_t>
-MessageBuffer&
-operator>>(MessageBuffer& msg, Uint_t& val)
+DecodeStatus
+try_decode(MessageBufferView& msg, Uint_t& val)
+{
+  constexpr size_t byte_length = sizeof(Uint_t);
+  if (msg.size() < byte_length)
+    return DecodeStatus::Truncated;
+
+  std::memcpy(&val, msg.pop_front(byte_length).data(), byte_length);
+  val = swap_bytes(val);
+
+  return DecodeStatus::Ok;
+}
+template DecodeStatus
+try_decode(MessageBufferView& msg, uint16_t& val);
+template DecodeStatus
+try_decode(MessageBufferView& msg, uint32_t& val);
+template DecodeStatus
+try_decode(MessageBufferView& msg, uint64_t& val);
+
+template<>
+DecodeStatus
+try_decode(MessageBufferView& msg, uint8_t& val)
+{
+  if (msg.empty())
+    return DecodeStatus::Truncated;
+
+  val = msg.front();
+  msg.pop();
+  return DecodeStatus::Ok;
+}
+
+template<typename Uint_t>
+MessageBufferView&
+operator>>(MessageBufferView& msg, Uint_t& val)
 {
   if (msg.empty()) {
     throw MessageBuffer::ReadException("Cannot read from empty message buffer");
   }
 
-  constexpr size_t byte_length = sizeof(Uint_t);
-  if (msg._buffer.size() < byte_length) {
+  if (try_decode(msg, val) != DecodeStatus::Ok) {
     throw MessageBuffer::ReadException(
       "Cannot read mismatched size buffer into size of type: Wanted " +
-      std::to_string(byte_length) + " but buffer only contains " +
-      std::to_string(msg._buffer.size()));
+      std::to_string(sizeof(Uint_t)) + " but buffer only contains " +
+      std::to_string(msg.size()));
   }
 
-  auto buffer_front = msg._buffer.begin();
-  auto buffer_byte_end =
-    std::next(buffer_front, std::min(msg._buffer.size(), byte_length));
-
-  std::copy_n(std::make_move_iterator(buffer_front),
-              byte_length,
-              reinterpret_cast<uint8_t*>(&val));
-  msg._buffer.erase(buffer_front, buffer_byte_end);
-  val = swap_bytes(val);
-
   return msg;
 }
+template MessageBufferView&
+operator>>(MessageBufferView& msg, uint8_t& val);
+template MessageBufferView&
+operator>>(MessageBufferView& msg, uint16_t& val);
+template MessageBufferView&
+operator>>(MessageBufferView& msg, uint32_t& val);
+template MessageBufferView&
+operator>>(MessageBufferView& msg, uint64_t& val);
+
+template<typename Uint_t>
+MessageBuffer&
+operator>>(MessageBuffer& msg, Uint_t& val)
+{
+  return read_from_view(msg, val);
+}
 template MessageBuffer&
 operator>>(MessageBuffer& msg, uint16_t& val);
 template MessageBuffer&
@@ -223,100 +379,97 @@ operator<<(MessageBuffer& msg, std::vector<uint8_t>&& val)
   return msg;
 }
 
-MessageBuffer&
-operator>>(MessageBuffer& msg, std::vector<uint8_t>& val)
+DecodeStatus
+try_decode(MessageBufferView& msg, std::span<const uint8_t>& val)
 {
   uintVar_t vec_size = 0;
-  msg >> vec_size;
+  if (auto status = try_decode(msg, vec_size); status != DecodeStatus::Ok)
+    return status;
+
+  if (msg.size() < vec_size)
+    return DecodeStatus::Truncated;
 
   val = msg.pop_front(vec_size);
-  return msg;
+  return DecodeStatus::Ok;
 }
 
-MessageBuffer&
-operator<<(MessageBuffer& msg, const uintVar_t& v)
+DecodeStatus
+try_decode(MessageBufferView& msg, std::vector<uint8_t>& val)
 {
-  uint64_t val = v;
+  std::span<const uint8_t> bytes;
+  if (auto status = try_decode(msg, bytes); status != DecodeStatus::Ok)
+    return status;
 
-  if (val < ((uint64_t)1 << 7)) {
-    msg.push(uint8_t(((val >> 0) & 0x7F)) | 0x00);
-    return msg;
-  }
+  val.assign(bytes.begin(), bytes.end());
+  return DecodeStatus::Ok;
+}
 
-  if (val < ((uint64_t)1 << 14)) {
-    msg.push(uint8_t(((val >> 8) & 0x3F) | 0x80));
-    msg.push(uint8_t((val >> 0) & 0xFF));
-    return msg;
-  }
+MessageBufferView&
+operator>>(MessageBufferView& msg, std::span<const uint8_t>& val)
+{
+  throw_on_error(try_decode(msg, val), "byte sequence");
+  return msg;
+}
 
-  if (val < ((uint64_t)1 << 29)) {
-    msg.push(uint8_t(((val >> 24) & 0x1F) | 0x80 | 0x40));
-    msg.push(uint8_t((val >> 16) & 0xFF));
-    msg.push(uint8_t((val >> 8) & 0xFF));
-    msg.push(uint8_t((val >> 0) & 0xFF));
-    return msg;
-  }
+MessageBufferView&
+operator>>(MessageBufferView& msg, std::vector<uint8_t>& val)
+{
+  throw_on_error(try_decode(msg, val), "byte sequence");
+  return msg;
+}
 
-  msg.push(uint8_t(((val >> 56) & 0x0F) | 0x80 | 0x40 | 0x20));
-  msg.push(uint8_t((val >> 48) & 0xFF));
-  msg.push(uint8_t((val >> 40) & 0xFF));
-  msg.push(uint8_t((val >> 32) & 0xFF));
-  msg.push(uint8_t((val >> 24) & 0xFF));
-  msg.push(uint8_t((val >> 16) & 0xFF));
-  msg.push(uint8_t((val >> 8) & 0xFF));
-  msg.push(uint8_t((val >> 0) & 0xFF));
+MessageBuffer&
+operator>>(MessageBuffer& msg, std::vector<uint8_t>& val)
+{
+  return read_from_view(msg, val);
+}
+
+MessageBuffer&
+operator<<(MessageBuffer& msg, const uintVar_t& v)
+{
+  uint8_t bytes[varint::max_size];
+  const auto length = varint::encode(v, bytes);
+  msg.push(std::span<const uint8_t>(bytes, length));
 
   return msg;
 }
 
 MessageBuffer&
-operator>>(MessageBuffer& msg, uintVar_t& v)
+operator<<(MessageBuffer& msg, std::span<const uintVar_t> values)
 {
-  uint8_t byte[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
-  uint8_t first = msg.front();
+  const auto length = varint::size(values);
+  const auto offset = msg._buffer.size();
+  msg._buffer.resize(offset + length);
+  varint::encode(values, msg._buffer.data() + offset);
 
-  if ((first & (0x80)) == 0) {
-    msg >> byte[0];
-    uint8_t val = ((byte[0] & 0x7F) << 0);
-    v = val;
-    return msg;
-  }
+  return msg;
+}
 
-  if ((first & (0x80 | 0x40)) == 0x80) {
-    msg >> byte[1];
-    msg >> byte[0];
-    uint16_t val = (((uint16_t)byte[1] & 0x3F) << 8) + ((uint16_t)byte[0] << 0);
-    v = val;
-    return msg;
-  }
+DecodeStatus
+try_decode(MessageBufferView& msg, uintVar_t& v)
+{
+  if (msg.empty())
+    return DecodeStatus::Truncated;
 
-  if ((first & (0x80 | 0x40 | 0x20)) == (0x80 | 0x40)) {
-    msg >> byte[3];
-    msg >> byte[2];
-    msg >> byte[1];
-    msg >> byte[0];
-    uint32_t val = ((uint32_t)(byte[3] & 0x1F) << 24) +
-                   ((uint32_t)byte[2] << 16) + ((uint32_t)byte[1] << 8) +
-                   ((uint32_t)byte[0] << 0);
-    v = val;
-    return msg;
-  }
+  const auto length = varint::length(msg.front());
+  if (msg.size() < length)
+    return DecodeStatus::Truncated;
 
-  msg >> byte[7];
-  msg >> byte[6];
-  msg >> byte[5];
-  msg >> byte[4];
-  msg >> byte[3];
-  msg >> byte[2];
-  msg >> byte[1];
-  msg >> byte[0];
-  uint64_t val = ((uint64_t)(byte[7] & 0x0F) << 56) +
-                 ((uint64_t)(byte[6]) << 48) + ((uint64_t)(byte[5]) << 40) +
-                 ((uint64_t)(byte[4]) << 32) + ((uint64_t)(byte[3]) << 24) +
-                 ((uint64_t)(byte[2]) << 16) + ((uint64_t)(byte[1]) << 8) +
-                 ((uint64_t)(byte[0]) << 0);
-  v = val;
+  v = varint::decode(msg.pop_front(length).data(), length);
+  return DecodeStatus::Ok;
+}
+
+MessageBufferView&
+operator>>(MessageBufferView& msg, uintVar_t& v)
+{
+  throw_on_error(try_decode(msg, v), "uintVar_t");
   return msg;
 }
 
+MessageBuffer&
+operator>>(MessageBuffer& msg, uintVar_t& v)
+{
+  return read_from_view(msg, v);
+}
+
 } // namespace quicr::messages
@@ -99,8 +99,9 @@ public:
 
   virtual void on_new_stream(
     const qtransport::TransportContextId& /* context_id */,
-    const qtransport::StreamId& /* mStreamId */)
+    const qtransport::StreamId& mStreamId)
   {
+    client.handle_new_stream(mStreamId);
   }
 
   virtual void on_recv_notify(const qtransport::TransportContextId& context_id,
@@ -117,10 +118,11 @@ public:
 //                << " stream_id: " << streamId
 //                << " data sz: " << data.value().size() << std::endl;
 
-      messages::MessageBuffer msg_buffer{data.value()};
+      const messages::BufferRelease release{ client.buffer_pool,
+                                             data.value() };
 
       try {
-        client.handle(std::move(msg_buffer));
+        client.handle(streamId, data.value());
       } catch (const messages::MessageBuffer::ReadException &e) {
         client.log_handler.log(qtransport::LogLevel::info,
                                "Dropping malformed message: " +
@@ -199,16 +201,28 @@ QuicRClient::QuicRClient(RelayInfo& relay_info,
   }
 
   make_transport(relay_info, std::move(tconfig), logger);
+
+  retry_thread = std::thread([this] { run_retry(); });
 }
 
 QuicRClient::QuicRClient(std::shared_ptr<ITransport> transport_in)
   : log_handler(def_log_handler)
 {
   transport = transport_in;
+
+  retry_thread = std::thread([this] { run_retry(); });
 }
 
 QuicRClient::~QuicRClient()
 {
+  {
+    std::lock_guard<std::mutex> lock(retry_mutex);
+    stopping = true;
+  }
+  retry_cv.notify_one();
+  retry_thread.join();
+
+  flush();
   removeSubscribeState(true, {},
                       SubscribeResult::SubscribeStatus::ConnectionClosed);
   transport.reset(); // wait for transport close
@@ -232,12 +246,10 @@ QuicRClient::publishIntent(std::shared_ptr<PublisherDelegate> pub_delegate,
                                   transport_stream_id,
                                   1 };
 
-  messages::MessageBuffer msg{ sizeof(messages::PublishIntent) +
-                               payload.size() };
+  messages::MessageBuffer msg{ messages::wire_size(intent) };
   msg << intent;
 
-  auto error =
-    transport->enqueue(transport_context_id, transport_stream_id, msg.get());
+  auto error = send(transport_stream_id, msg.get(), true);
 
   return error == qtransport::TransportError::None;
 }
@@ -259,10 +271,10 @@ QuicRClient::publishIntentEnd(const quicr::Namespace& quicr_namespace,
     {} // TODO: Figure out payload.
   };
 
-  messages::MessageBuffer msg;
+  messages::MessageBuffer msg{ messages::wire_size(intent_end) };
   msg << intent_end;
 
-  transport->enqueue(transport_context_id, transport_stream_id, msg.get());
+  send(transport_stream_id, msg.get(), true);
 }
 
 void
@@ -282,9 +294,9 @@ QuicRClient::subscribe(std::shared_ptr<SubscriberDelegate> subscriber_delegate,
   }
 
   // encode subscribe
-  messages::MessageBuffer msg{};
   auto transaction_id = messages::create_transaction_id();
   messages::Subscribe subscribe{ 0x1, transaction_id, quicr_namespace, intent };
+  messages::MessageBuffer msg{ messages::wire_size(subscribe) };
   msg << subscribe;
 
   // qtransport::MediaStreamId msid{};
@@ -296,7 +308,7 @@ QuicRClient::subscribe(std::shared_ptr<SubscriberDelegate> subscriber_delegate,
                         transport_context_id,
                         transport_stream_id,
                         transaction_id };
-    transport->enqueue(transport_context_id, transport_stream_id, msg.get());
+    send(transport_stream_id, msg.get(), true);
     return;
   } else {
     auto& ctx = subscribe_state[quicr_namespace];
@@ -306,7 +318,7 @@ QuicRClient::subscribe(std::shared_ptr<SubscriberDelegate> subscriber_delegate,
     } else if (ctx.state == SubscribeContext::State::Pending) {
       // todo - resend or wait or may be take in timeout in the api
     }
-    transport->enqueue(transport_context_id, transport_stream_id, msg.get());
+    send(transport_stream_id, msg.get(), true);
   }
 }
 
@@ -353,34 +365,35 @@ QuicRClient::unsubscribe(const quicr::Namespace& quicr_namespace,
   // The removal of the delegate is done on receive of subscription ended
   std::lock_guard<std::mutex> lock(mutex);
 
-  messages::MessageBuffer msg{};
   messages::Unsubscribe unsub{ 0x1, quicr_namespace };
+  messages::MessageBuffer msg{ messages::wire_size(unsub) };
   msg << unsub;
 
   if (subscribe_state.count(quicr_namespace)) {
     subscribe_state.erase(quicr_namespace);
   }
 
-  transport->enqueue(transport_context_id, transport_stream_id, msg.get());
+  send(transport_stream_id, msg.get(), true);
 }
 
 
 
 void
 QuicRClient::publishNamedObject(const quicr::Name& quicr_name,
-                                [[maybe_unused]] uint8_t priority,
-                                [[maybe_unused]] uint16_t expiry_age_ms,
-                                [[maybe_unused]] bool use_reliable_transport,
+                                uint8_t priority,
+                                uint16_t expiry_age_ms,
+                                bool use_reliable_transport,
                                 bytes&& data)
 {
-  // start populating message to encode
-  messages::PublishDatagram datagram;
+  // start populating message to encode, the payload is referenced from data
+  messages::PublishDatagramView datagram;
   // retrieve the context
   PublishContext context{};
 
   if (!publish_state.count(quicr_name)) {
     context.transport_context_id = transport_context_id;
-    context.transport_stream_id = transport_stream_id;
+    context.transport_stream_id = object_streams.get(
+      *transport, transport_context_id, priority, use_reliable_transport);
     context.state = PublishContext::State::Pending;
     context.group_id = 0;
     context.object_id = 0;
@@ -388,11 +401,12 @@ QuicRClient::publishNamedObject(const quicr::Name& quicr_name,
     // TODO: Never hit this since context is not added to published state and
     // objects are not to be repeated
     context = publish_state[quicr_name];
-    datagram.header.media_id = static_cast<uintVar_t>(context.transport_stream_id);
+    datagram.header.media_id = static_cast<uintVar_t>(transport_stream_id);
   }
 
+  // The media id stays the connection's, whichever stream carries the object
   datagram.header.name = quicr_name;
-  datagram.header.media_id = static_cast<uintVar_t>(context.transport_stream_id);
+  datagram.header.media_id = static_cast<uintVar_t>(transport_stream_id);
   datagram.header.group_id = static_cast<uintVar_t>(context.group_id);
   datagram.header.object_id = static_cast<uintVar_t>(context.object_id);
   datagram.header.flags = 0x0;
@@ -401,18 +415,15 @@ QuicRClient::publishNamedObject(const quicr::Name& quicr_name,
 
   // Fragment the payload if needed
   if (data.size() <= quicr::MAX_TRANSPORT_DATA_SIZE) {
-    messages::MessageBuffer msg;
-
     datagram.media_data_length = static_cast<uintVar_t>(data.size());
-    datagram.media_data = std::move(data);
-
-    msg << datagram;
+    datagram.media_data = data;
 
     // No fragmenting needed
-    // TODO: Add metric for dropping packets due to queue full == qtransport::TransportError::QueueFull
-    transport->enqueue(transport_context_id,
-                       context.transport_stream_id,
-                       msg.get());
+    schedule(priority,
+             expiry_age_ms,
+             context.transport_stream_id,
+             messages::encode_segments(datagram, buffer_pool).gather(),
+             false);
 
   } else {
     // Fragments required. At this point this only counts whole blocks
@@ -421,65 +432,241 @@ QuicRClient::publishNamedObject(const quicr::Name& quicr_name,
 
     int offset = 0;
 
-    while (frag_num-- > 0) {
-      messages::MessageBuffer msg;
+    // Queued as one object, so it is sent or expires whole
+    std::vector<std::vector<uint8_t>> fragments;
+    fragments.reserve(frag_num + 1);
 
+    while (frag_num-- > 0) {
       if (frag_num == 0 && !frag_remaining_bytes) {
         datagram.header.offset_and_fin = (offset << 1) + 1;
       } else {
         datagram.header.offset_and_fin = offset << 1;
       }
 
-      bytes frag_data(data.begin() + offset,
-                      data.begin() + offset + quicr::MAX_TRANSPORT_DATA_SIZE);
-
-      datagram.media_data_length = frag_data.size();
-      datagram.media_data = std::move(frag_data);
-
-      msg << datagram;
+      datagram.media_data_length = quicr::MAX_TRANSPORT_DATA_SIZE;
+      datagram.media_data =
+        std::span(data).subspan(offset, quicr::MAX_TRANSPORT_DATA_SIZE);
 
       offset += quicr::MAX_TRANSPORT_DATA_SIZE;
 
-      /*
-       * For UDP based transports, some level of pacing is required to prevent
-       * buffer overruns throughput the network path and with the remote end.
-       *  TODO: Fix... This is set a bit high because the server code is running
-       * too slow
-       */
-      if (need_pacing && (frag_num % 30) == 0)
-        std::this_thread::sleep_for(std::chrono::milliseconds(1));
-
-      if (transport->enqueue(transport_context_id,
-                     context.transport_stream_id,
-                             msg.get()) != qtransport::TransportError::None) {
-        std::this_thread::sleep_for(std::chrono::microseconds(100));
-        // No point in finishing fragment if one is dropped
-        return;
-      }
+      fragments.push_back(
+        messages::encode_segments(datagram, buffer_pool).gather());
     }
 
     // Send last fragment, which will be less than MAX_TRANSPORT_DATA_SIZE
     if (frag_remaining_bytes) {
-        messages::MessageBuffer msg;
         datagram.header.offset_and_fin = uintVar_t((offset << 1) + 1);
 
-        bytes frag_data(data.begin() + offset, data.end());
-        datagram.media_data_length = static_cast<uintVar_t>(frag_data.size());
-        datagram.media_data = std::move(frag_data);
-
-        msg << datagram;
+        datagram.media_data = std::span(data).subspan(offset);
+        datagram.media_data_length =
+          static_cast<uintVar_t>(datagram.media_data.size());
 
         //			std::cout << "Pub-frag remaining msg size: " <<
         // data.size()
         //			          << " offset: " <<
         // uint64_t(datagram.header.offset_and_fin) << std::endl;
 
-        if (transport->enqueue(transport_context_id,
-                               context.transport_stream_id,
-                               msg.get()) != qtransport::TransportError::None) {
-        std::this_thread::sleep_for(std::chrono::microseconds(100));
-        }
+        fragments.push_back(
+          messages::encode_segments(datagram, buffer_pool).gather());
+      }
+
+    schedule_fragments(priority,
+                       expiry_age_ms,
+                       context.transport_stream_id,
+                       std::move(fragments),
+                       true);
+  }
+}
+
+void
+QuicRClient::setCoalescing(bool enabled)
+{
+  if (!enabled) {
+    flush();
+  }
+
+  coalesce = enabled;
+}
+
+qtransport::TransportError
+QuicRClient::flush()
+{
+  auto error = qtransport::TransportError::None;
+  {
+    std::lock_guard<std::mutex> lock(scheduler_mutex);
+    error = drain_scheduled();
+  }
+
+  std::lock_guard<std::mutex> lock(batch_mutex);
+
+  for (auto& [stream_id, batch] : pending_batches) {
+    if (auto batch_error = send_batch(stream_id, batch);
+        batch_error != qtransport::TransportError::None) {
+      error = batch_error;
+    }
+  }
+
+  return error;
+}
+
+qtransport::TransportError
+QuicRClient::send_batch(const qtransport::StreamId& stream_id,
+                        messages::MessageBatch& batch)
+{
+  if (batch.empty())
+    return qtransport::TransportError::None;
+
+  auto error =
+    transport->enqueue(transport_context_id, stream_id, batch.encode());
+
+  // Keep the messages to retry once the queue drains
+  if (error == qtransport::TransportError::QueueFull)
+    retry_later();
+  else
+    batch.clear();
+
+  return error;
+}
+
+qtransport::TransportError
+QuicRClient::send(const qtransport::StreamId& stream_id,
+                  std::vector<uint8_t>&& packet,
+                  bool flush_now)
+{
+  return try_send(stream_id, packet, flush_now).error;
+}
+
+SendScheduler::Result
+QuicRClient::try_send(const qtransport::StreamId& stream_id,
+                      std::vector<uint8_t>& packet,
+                      bool flush_now)
+{
+  const auto enqueue = [&] {
+    const auto error =
+      transport->enqueue(transport_context_id, stream_id, std::move(packet));
+    return SendScheduler::Result{
+      error != qtransport::TransportError::QueueFull, error
+    };
+  };
+
+  if (!coalesce) {
+    return enqueue();
+  }
+
+  std::lock_guard<std::mutex> lock(batch_mutex);
+
+  auto error = qtransport::TransportError::None;
+  auto& batch = pending_batches[stream_id];
+
+  if (!batch.fits(packet.size())) {
+    error = send_batch(stream_id, batch);
+
+    // The batch is still pending, so packet cannot follow it yet
+    if (error == qtransport::TransportError::QueueFull)
+      return { false, error };
+  }
+
+  // Too large to share a payload, send as is now that the batch is flushed
+  if (!batch.fits(packet.size())) {
+    return enqueue();
+  }
+
+  batch.append(packet);
+  buffer_pool.release(std::move(packet));
+
+  if (flush_now) {
+    error = send_batch(stream_id, batch);
+  }
+
+  return { true, error };
+}
+
+qtransport::TransportError
+QuicRClient::schedule(uint8_t priority,
+                      uint16_t expiry_age_ms,
+                      const qtransport::StreamId& stream_id,
+                      std::vector<uint8_t>&& packet,
+                      bool flush_now)
+{
+  std::lock_guard<std::mutex> lock(scheduler_mutex);
+
+  scheduler.push(
+    priority, expiry_age_ms, stream_id, std::move(packet), flush_now);
+
+  return drain_scheduled();
+}
+
+qtransport::TransportError
+QuicRClient::schedule_fragments(uint8_t priority,
+                                uint16_t expiry_age_ms,
+                                const qtransport::StreamId& stream_id,
+                                std::vector<std::vector<uint8_t>>&& fragments,
+                                bool flush_now)
+{
+  std::lock_guard<std::mutex> lock(scheduler_mutex);
+
+  scheduler.push_fragments(
+    priority, expiry_age_ms, stream_id, std::move(fragments), flush_now);
+
+  return drain_scheduled();
+}
+
+qtransport::TransportError
+QuicRClient::drain_scheduled()
+{
+  const auto error = scheduler.drain([this](const qtransport::StreamId& stream,
+                                            std::vector<uint8_t>& packet,
+                                            bool flush_now) {
+    if (need_pacing) {
+      const auto now = SendScheduler::Clock::now();
+      if (now - pacing_start >= pacing_interval) {
+        pacing_start = now;
+        paced_bytes = 0;
       }
+
+      // Over budget, held back for the retry thread rather than slept on
+      if (paced_bytes >= pacing_burst)
+        return SendScheduler::Result{ false,
+                                      qtransport::TransportError::None };
+
+      paced_bytes += packet.size();
+    }
+
+    return try_send(stream, packet, flush_now);
+  });
+
+  if (!scheduler.empty())
+    retry_later();
+
+  return error;
+}
+
+void
+QuicRClient::retry_later()
+{
+  {
+    std::lock_guard<std::mutex> lock(retry_mutex);
+    retry_pending = true;
+  }
+  retry_cv.notify_one();
+}
+
+void
+QuicRClient::run_retry()
+{
+  std::unique_lock<std::mutex> lock(retry_mutex);
+
+  while (true) {
+    retry_cv.wait(lock, [this] { return stopping || retry_pending; });
+
+    // Give the transport time to drain its queue before trying again
+    if (retry_cv.wait_for(lock, retry_interval, [this] { return stopping; }))
+      return;
+
+    retry_pending = false;
+    lock.unlock();
+    flush();
+    lock.lock();
   }
 }
 
@@ -579,8 +766,77 @@ QuicRClient::handle_pub_fragment(messages::PublishDatagram&& datagram)
   }
 }
 
+void
+QuicRClient::handle_publish(messages::PublishDatagramView&& datagram)
+{
+  if (datagram.header.offset_and_fin == uintVar_t(0x1)) {
+    // No-fragment, process as single object
+
+    for (const auto& entry : sub_delegates) {
+      if (entry.first.contains(datagram.header.name)) {
+        if (auto sub_delegate = sub_delegates[entry.first].lock())
+          sub_delegate->onSubscribedObject(
+            datagram.header.name,
+            0x0,
+            0x0,
+            false,
+            { datagram.media_data.begin(), datagram.media_data.end() });
+      }
+    }
+  } else { // is a fragment
+    handle_pub_fragment({ datagram.header,
+                          datagram.media_type,
+                          datagram.media_data_length,
+                          { datagram.media_data.begin(),
+                            datagram.media_data.end() } });
+  }
+}
+
+void
+QuicRClient::handle_new_stream(const qtransport::StreamId& stream_id)
+{
+  std::lock_guard<std::mutex> lock(stream_decoder_mutex);
+  stream_decoders.try_emplace(stream_id);
+}
+
+void
+QuicRClient::handle(const qtransport::StreamId& stream_id,
+                    std::span<const uint8_t> data)
+{
+  messages::StreamDecoder* decoder = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(stream_decoder_mutex);
+    if (const auto it = stream_decoders.find(stream_id);
+        it != stream_decoders.end())
+      decoder = &it->second;
+  }
+
+  if (!decoder) {
+    handle(messages::MessageBufferView{ data });
+    return;
+  }
+
+  const auto status = decoder->push(
+    data,
+    [this](messages::MessageBufferView&& msg) { handle(std::move(msg)); },
+    [this](messages::PublishDatagramView&& fragment) {
+      handle_publish(std::move(fragment));
+    });
+
+  if (status != messages::DecodeStatus::Ok) {
+    log_handler.log(qtransport::LogLevel::info,
+                    "Dropping malformed stream data");
+  }
+}
+
 void
 QuicRClient::handle(messages::MessageBuffer&& msg)
+{
+  handle(msg.view());
+}
+
+void
+QuicRClient::handle(messages::MessageBufferView&& msg)
 {
   if (msg.empty()) {
     std::cout << "Transport Reported Empty Data" << std::endl;
@@ -591,7 +847,11 @@ QuicRClient::handle(messages::MessageBuffer&& msg)
   switch (msg_type) {
     case messages::MessageType::SubscribeResponse: {
       messages::SubscribeResponse response;
-      msg >> response;
+      if (messages::try_decode(msg, response) != messages::DecodeStatus::Ok) {
+        log_handler.log(qtransport::LogLevel::info,
+                        "Dropping malformed message");
+        return;
+      }
 
       SubscribeResult result{ .status = response.response };
 
@@ -608,7 +868,11 @@ QuicRClient::handle(messages::MessageBuffer&& msg)
 
     case messages::MessageType::SubscribeEnd: {
       messages::SubscribeEnd subEnd;
-      msg >> subEnd;
+      if (messages::try_decode(msg, subEnd) != messages::DecodeStatus::Ok) {
+        log_handler.log(qtransport::LogLevel::info,
+                        "Dropping malformed message");
+        return;
+      }
 
       removeSubscribeState(false, subEnd.quicr_namespace, subEnd.reason);
 
@@ -616,24 +880,26 @@ QuicRClient::handle(messages::MessageBuffer&& msg)
     }
 
     case messages::MessageType::Publish: {
-      messages::PublishDatagram datagram;
-      msg >> datagram;
-
-      if (datagram.header.offset_and_fin == uintVar_t(0x1)) {
-        // No-fragment, process as single object
-
-        for (const auto& entry : sub_delegates) {
-          if (entry.first.contains(datagram.header.name)) {
-            if (auto sub_delegate = sub_delegates[entry.first].lock())
-              sub_delegate->onSubscribedObject(datagram.header.name,
-                                               0x0,
-                                               0x0,
-                                               false,
-                                               std::move(datagram.media_data));
-          }
-        }
-      } else { // is a fragment
-        handle_pub_fragment(std::move(datagram));
+      messages::PublishDatagramView datagram;
+      if (messages::try_decode(msg, datagram) != messages::DecodeStatus::Ok) {
+        log_handler.log(qtransport::LogLevel::info,
+                        "Dropping malformed message");
+        return;
+      }
+
+      handle_publish(std::move(datagram));
+      break;
+    }
+
+    case messages::MessageType::Batch: {
+      auto status = messages::for_each_batched(
+        msg.data(), [this](messages::MessageBufferView&& message) {
+          handle(std::move(message));
+        });
+
+      if (status != messages::DecodeStatus::Ok) {
+        log_handler.log(qtransport::LogLevel::info,
+                        "Dropping malformed message");
       }
 
       break;
@@ -641,7 +907,11 @@ QuicRClient::handle(messages::MessageBuffer&& msg)
 
     case messages::MessageType::PublishIntentResponse: {
       messages::PublishIntentResponse response;
-      msg >> response;
+      if (messages::try_decode(msg, response) != messages::DecodeStatus::Ok) {
+        log_handler.log(qtransport::LogLevel::info,
+                        "Dropping malformed message");
+        return;
+      }
 
       if (!pub_delegates.count(response.quicr_namespace)) {
         std::cout
@@ -6,6 +6,7 @@
 #include <quicr/encode.h>
 #include <quicr/message_buffer.h>
 #include <sstream>
+#include <stdexcept>
 #include <thread>
 
 #include <arpa/inet.h>
@@ -25,6 +26,23 @@ ServerDelegate::onSubscribe(
 {
 }
 
+void
+ServerDelegate::onPublisherObjectBytes(
+  const qtransport::TransportContextId& context_id,
+  const qtransport::StreamId& stream_id,
+  bool use_reliable_transport,
+  const messages::Header& /*header*/,
+  std::span<const uint8_t> encoded)
+{
+  messages::MessageBufferView msg{ encoded };
+  messages::PublishDatagram datagram;
+  if (messages::try_decode(msg, datagram) != messages::DecodeStatus::Ok)
+    return;
+
+  onPublisherObject(
+    context_id, stream_id, use_reliable_transport, std::move(datagram));
+}
+
 void
 ServerDelegate::onUnsubscribe(const quicr::Namespace& /*quicr_namespace*/,
                               const uint64_t& /*subscriber_id*/,
@@ -70,6 +88,11 @@ QuicRServer::QuicRServer(std::shared_ptr<qtransport::ITransport> transport_in,
 {
 }
 
+QuicRServer::~QuicRServer()
+{
+  stop_workers();
+}
+
 std::shared_ptr<qtransport::ITransport>
 QuicRServer::setupTransport([[maybe_unused]] RelayInfo& relayInfo,
                             qtransport::TransportConfig cfg)
@@ -116,10 +139,17 @@ void
 QuicRServer::publishIntentResponse(const quicr::Namespace& quicr_namespace,
                                    const PublishIntentResult& result)
 {
-  if (!publish_namespaces.count(quicr_namespace))
-    return;
+  PublishIntentContext context;
+  {
+    std::lock_guard<std::shared_mutex> lock(publish_namespaces_mutex);
+    auto context_ptr = publish_namespaces.find(quicr_namespace);
+    if (!context_ptr)
+      return;
+
+    context_ptr->state = PublishIntentContext::State::Ready;
+    context = *context_ptr;
+  }
 
-  auto& context = publish_namespaces[quicr_namespace];
   messages::PublishIntentResponse response{
     messages::MessageType::PublishIntentResponse,
     quicr_namespace,
@@ -127,13 +157,13 @@ QuicRServer::publishIntentResponse(const quicr::Namespace& quicr_namespace,
     context.transaction_id
   };
 
-  messages::MessageBuffer msg(sizeof(response));
+  messages::MessageBuffer msg{ messages::wire_size(response) };
   msg << response;
 
-  context.state = PublishIntentContext::State::Ready;
-
-  transport->enqueue(
-    context.transport_context_id, context.transport_stream_id, msg.get());
+  send(context.transport_context_id,
+       context.transport_stream_id,
+       msg.get(),
+       true);
 }
 
 void
@@ -141,23 +171,29 @@ QuicRServer::subscribeResponse(const uint64_t& subscriber_id,
                                const quicr::Namespace& quicr_namespace,
                                const SubscribeResult& result)
 {
-  // start populating message to encode
-  if (subscribe_id_state.count(subscriber_id) == 0) {
-    return;
-  }
+  SubscribeContext context;
+  {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    auto it = subscribe_id_state.find(subscriber_id);
+    if (it == subscribe_id_state.end()) {
+      return;
+    }
 
-  auto& context = subscribe_id_state[subscriber_id];
+    context = it->second;
+  }
 
   messages::SubscribeResponse response;
   response.transaction_id = subscriber_id;
   response.quicr_namespace = quicr_namespace;
   response.response = result.status;
 
-  messages::MessageBuffer msg;
+  messages::MessageBuffer msg{ messages::wire_size(response) };
   msg << response;
 
-  transport->enqueue(
-    context.transport_context_id, context.transport_stream_id, msg.get());
+  send(context.transport_context_id,
+       context.transport_stream_id,
+       msg.get(),
+       true);
 }
 
 void
@@ -165,71 +201,482 @@ QuicRServer::subscriptionEnded(const uint64_t& subscriber_id,
                                const quicr::Namespace& quicr_namespace,
                                const SubscribeResult::SubscribeStatus& reason)
 {
-  // start populating message to encode
-  if (subscribe_id_state.count(subscriber_id) == 0) {
-    return;
-  }
+  SubscribeContext context;
+  {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    auto it = subscribe_id_state.find(subscriber_id);
+    if (it == subscribe_id_state.end()) {
+      return;
+    }
 
-  auto& context = subscribe_id_state[subscriber_id];
+    context = it->second;
+  }
 
   messages::SubscribeEnd subEnd;
   subEnd.quicr_namespace = quicr_namespace;
   subEnd.reason = reason;
 
-  messages::MessageBuffer msg;
+  messages::MessageBuffer msg{ messages::wire_size(subEnd) };
   msg << subEnd;
 
-  transport->enqueue(
-    context.transport_context_id, context.transport_stream_id, msg.get());
+  send(context.transport_context_id,
+       context.transport_stream_id,
+       msg.get(),
+       true);
 }
 
 void
 QuicRServer::sendNamedObject(const uint64_t& subscriber_id,
-                             [[maybe_unused]] bool use_reliable_transport,
+                             uint8_t priority,
+                             bool use_reliable_transport,
                              const messages::PublishDatagram& datagram)
 {
-  // start populating message to encode
-  if (subscribe_id_state.count(subscriber_id) == 0) {
-    return;
+  SubscribeContext context;
+  {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    auto it = subscribe_id_state.find(subscriber_id);
+    if (it == subscribe_id_state.end()) {
+      return;
+    }
+
+    context = it->second;
   }
 
-  auto& context = subscribe_id_state[subscriber_id];
-  messages::MessageBuffer msg;
+  sendNamedObject(context.transport_context_id,
+                  context.transport_stream_id,
+                  priority,
+                  use_reliable_transport,
+                  datagram);
+}
 
+void
+QuicRServer::sendNamedObject(const qtransport::TransportContextId& context_id,
+                             const qtransport::StreamId& /* stream_id */,
+                             uint8_t priority,
+                             bool use_reliable_transport,
+                             const messages::PublishDatagram& datagram)
+{
+  messages::MessageBuffer msg{ messages::wire_size(datagram), buffer_pool };
   msg << datagram;
 
-  transport->enqueue(
-    context.transport_context_id, context.transport_stream_id, msg.get());
+  send(context_id,
+       object_streams.get(
+         *transport, context_id, priority, use_reliable_transport),
+       msg.get(),
+       false);
+}
+
+void
+QuicRServer::sendNamedObjectToMany(std::span<const uint64_t> subscriber_ids,
+                                   uint8_t priority,
+                                   bool use_reliable_transport,
+                                   const messages::PublishDatagram& datagram)
+{
+  // Look the subscribers up under one lock, and send to them unlocked
+  std::vector<SubscribeContext> contexts;
+  contexts.reserve(subscriber_ids.size());
+  {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    for (const auto& subscriber_id : subscriber_ids) {
+      auto it = subscribe_id_state.find(subscriber_id);
+      if (it != subscribe_id_state.end()) {
+        contexts.push_back(it->second);
+      }
+    }
+  }
+
+  const auto encoded = encodeNamedObject(datagram);
+
+  for (const auto& context : contexts) {
+    sendEncodedObject(context.transport_context_id,
+                      context.transport_stream_id,
+                      priority,
+                      use_reliable_transport,
+                      encoded.view().data());
+  }
+}
+
+messages::MessageBuffer
+QuicRServer::encodeNamedObject(const messages::PublishDatagram& datagram)
+{
+  messages::MessageBuffer msg{ messages::wire_size(datagram), buffer_pool };
+  msg << datagram;
+  return msg;
+}
+
+void
+QuicRServer::sendEncodedObject(const qtransport::TransportContextId& context_id,
+                               const qtransport::StreamId& /* stream_id */,
+                               uint8_t priority,
+                               bool use_reliable_transport,
+                               std::span<const uint8_t> encoded)
+{
+  auto packet = buffer_pool.acquire(encoded.size());
+  packet.assign(encoded.begin(), encoded.end());
+
+  send(context_id,
+       object_streams.get(
+         *transport, context_id, priority, use_reliable_transport),
+       std::move(packet),
+       false);
+}
+
+void
+QuicRServer::forwardEncodedObject(
+  const qtransport::TransportContextId& context_id,
+  const qtransport::TransportContextId& source_context_id,
+  const qtransport::StreamId& source_stream_id,
+  bool use_reliable_transport,
+  std::span<const uint8_t> encoded)
+{
+  auto packet = buffer_pool.acquire(encoded.size());
+  packet.assign(encoded.begin(), encoded.end());
+
+  send(context_id,
+       object_streams.get(*transport,
+                          context_id,
+                          source_context_id,
+                          source_stream_id,
+                          use_reliable_transport),
+       std::move(packet),
+       false);
+}
+
+void
+QuicRServer::setCoalescing(bool enabled)
+{
+  if (!enabled) {
+    flush();
+  }
+
+  coalesce = enabled;
+}
+
+qtransport::TransportError
+QuicRServer::flush()
+{
+  auto error = qtransport::TransportError::None;
+  std::lock_guard<std::mutex> lock(batch_mutex);
+
+  for (auto& [destination, batch] : pending_batches) {
+    if (auto batch_error =
+          send_batch(destination.first, destination.second, batch);
+        batch_error != qtransport::TransportError::None) {
+      error = batch_error;
+    }
+  }
+
+  return error;
+}
+
+qtransport::TransportError
+QuicRServer::send_batch(const qtransport::TransportContextId& context_id,
+                        const qtransport::StreamId& stream_id,
+                        messages::MessageBatch& batch)
+{
+  if (batch.empty())
+    return qtransport::TransportError::None;
+
+  auto error = transport->enqueue(context_id, stream_id, batch.encode());
+
+  // Keep the messages to retry once the queue drains
+  if (error != qtransport::TransportError::QueueFull)
+    batch.clear();
+
+  return error;
+}
+
+qtransport::TransportError
+QuicRServer::send(const qtransport::TransportContextId& context_id,
+                  const qtransport::StreamId& stream_id,
+                  std::vector<uint8_t>&& packet,
+                  bool flush_now)
+{
+  if (!coalesce) {
+    return transport->enqueue(context_id, stream_id, std::move(packet));
+  }
+
+  std::lock_guard<std::mutex> lock(batch_mutex);
+
+  auto error = qtransport::TransportError::None;
+  auto& batch = pending_batches[{ context_id, stream_id }];
+
+  if (!batch.fits(packet.size())) {
+    error = send_batch(context_id, stream_id, batch);
+
+    // The batch is still pending, so packet cannot follow it yet
+    if (error == qtransport::TransportError::QueueFull)
+      return error;
+  }
+
+  // Too large to share a payload, send as is now that the batch is flushed
+  if (!batch.fits(packet.size())) {
+    return transport->enqueue(context_id, stream_id, std::move(packet));
+  }
+
+  batch.append(packet);
+  buffer_pool.release(std::move(packet));
+
+  if (flush_now) {
+    error = send_batch(context_id, stream_id, batch);
+  }
+
+  return error;
+}
+
+void
+QuicRServer::setReceiveWorkers(size_t count)
+{
+  if (running || !workers().empty()) {
+    throw std::runtime_error("Receive workers must be set once, before run()");
+  }
+
+  if (count == 0)
+    return;
+
+  // Transport threads only read receive_workers once the count is published
+  std::vector<std::unique_ptr<ReceiveWorker>> created;
+  for (size_t i = 0; i < count; ++i) {
+    created.push_back(std::make_unique<ReceiveWorker>());
+  }
+  receive_workers = std::move(created);
+
+  for (auto& worker : receive_workers) {
+    worker->thread = std::thread([this, &worker = *worker] {
+      run_worker(worker);
+    });
+  }
+
+  receive_worker_count.store(count, std::memory_order_release);
 }
 
 ///
 /// Private
 ///
 
+void
+QuicRServer::receive(PublishShard& shard,
+                     const qtransport::TransportContextId& context_id,
+                     const qtransport::StreamId& streamId)
+{
+  std::shared_ptr<messages::StreamDecoder> decoder;
+  {
+    std::lock_guard<std::mutex> lock(stream_decoder_mutex);
+    if (const auto it = stream_decoders.find({ context_id, streamId });
+        it != stream_decoders.end())
+      decoder = it->second;
+  }
+
+  // don't starve other queues, read some number of messages at a time
+  for (int i=0; i < 150; i++) {
+    auto data = transport->dequeue(context_id, streamId);
+
+    if (data.has_value()) {
+      const messages::BufferRelease release{ buffer_pool, data.value() };
+
+      try {
+        if (!decoder) {
+          handle(shard,
+                 context_id,
+                 streamId,
+                 messages::MessageBufferView{ data.value() });
+          continue;
+        }
+
+        const auto status = decoder->push(
+          data.value(),
+          [&](messages::MessageBufferView&& msg) {
+            handle(shard, context_id, streamId, std::move(msg));
+          },
+          [&](messages::PublishDatagramView&& fragment) {
+            handle_publish_fragment(
+              shard, context_id, streamId, std::move(fragment));
+          });
+
+        if (status != messages::DecodeStatus::Ok) {
+          log_handler.log(qtransport::LogLevel::info,
+                          "Dropping malformed stream data");
+        }
+      } catch (const messages::MessageBuffer::ReadException& /* ex */) {
+        continue;
+      } catch (const std::exception& /* ex */) {
+        continue;
+      } catch (...) {
+        log_handler.log(
+          qtransport::LogLevel::fatal,
+          "Received unknown error while reading from message buffer.");
+        throw;
+      }
+    } else {
+      break;
+    }
+  }
+}
+
+void
+QuicRServer::dispatch(const qtransport::TransportContextId& context_id,
+                      ReceiveWorker::Task&& task)
+{
+  auto& worker = worker_for(context_id);
+  while (!worker.tasks.try_push(std::move(task))) {
+    // Hold the transport back until the worker has room, reading drained
+    // before retrying so a drain after the retry ends the wait
+    const auto drained = worker.drained.load(std::memory_order_acquire);
+    if (worker.stopping)
+      return;
+    if (worker.tasks.try_push(std::move(task)))
+      break;
+    worker.drained.wait(drained, std::memory_order_acquire);
+  }
+
+  worker.signal.fetch_add(1, std::memory_order_release);
+  worker.signal.notify_one();
+}
+
+std::span<const std::unique_ptr<QuicRServer::ReceiveWorker>>
+QuicRServer::workers() const
+{
+  const auto count = receive_worker_count.load(std::memory_order_acquire);
+  if (count == 0)
+    return {};
+
+  return { receive_workers.data(), count };
+}
+
+void
+QuicRServer::stop_workers()
+{
+  for (auto& worker : workers()) {
+    worker->stopping = true;
+    worker->signal.fetch_add(1, std::memory_order_release);
+    worker->signal.notify_one();
+    worker->drained.fetch_add(1, std::memory_order_release);
+    worker->drained.notify_all();
+  }
+
+  for (auto& worker : workers()) {
+    if (worker->thread.joinable()) {
+      worker->thread.join();
+    }
+  }
+}
+
+QuicRServer::ReceiveWorker&
+QuicRServer::worker_for(const qtransport::TransportContextId& context_id)
+{
+  const auto hash = std::hash<qtransport::TransportContextId>{}(context_id);
+  const auto all = workers();
+  return *all[hash % all.size()];
+}
+
+void
+QuicRServer::run_worker(ReceiveWorker& worker)
+{
+  ReceiveWorker::Task task;
+  quicr::Namespace ended;
+
+  while (!worker.stopping) {
+    // Read before draining, so a push after the drain ends the wait below
+    const auto signal = worker.signal.load(std::memory_order_acquire);
+    bool idle = true;
+
+    while (worker.ended_intents.try_pop(ended)) {
+      worker.shard.end_publish_intent(ended);
+      idle = false;
+    }
+
+    while (worker.tasks.try_pop(task)) {
+      receive(worker.shard, task.context_id, task.stream_id);
+      idle = false;
+    }
+
+    if (!idle) {
+      worker.drained.fetch_add(1, std::memory_order_release);
+      worker.drained.notify_all();
+    }
+
+    if (idle) {
+      worker.signal.wait(signal, std::memory_order_acquire);
+    }
+  }
+}
+
+void
+QuicRServer::PublishShard::end_publish_intent(
+  const quicr::Namespace& quicr_namespace)
+{
+  auto it = intent_names.find(quicr_namespace);
+  if (it == intent_names.end())
+    return;
+
+  // Names may also be listed by an enclosing intent, and already be erased
+  for (const auto& name : it->second)
+    publish_state.erase(name);
+
+  intent_names.erase(it);
+}
+
+void
+QuicRServer::end_publish_intent(PublishShard& shard,
+                                const quicr::Namespace& quicr_namespace)
+{
+  shard.end_publish_intent(quicr_namespace);
+
+  // Worker that owns shard, or none on the transport's thread
+  const auto all = workers();
+  const auto own_it = std::find_if(all.begin(), all.end(), [&](const auto& w) {
+    return &w->shard == &shard;
+  });
+  ReceiveWorker* own = own_it != all.end() ? own_it->get() : nullptr;
+
+  for (auto& worker : all) {
+    if (worker.get() == own)
+      continue;
+
+    quicr::Namespace ended{ quicr_namespace };
+    while (!worker->ended_intents.try_push(std::move(ended))) {
+      // Drain our own queue meanwhile, so workers ending intents at the same
+      // time never wait on each other
+      quicr::Namespace own_ended;
+      while (own && own->ended_intents.try_pop(own_ended))
+        shard.end_publish_intent(own_ended);
+
+      std::this_thread::yield();
+    }
+
+    worker->signal.fetch_add(1, std::memory_order_release);
+    worker->signal.notify_one();
+  }
+}
+
 void
 QuicRServer::handle_subscribe(const qtransport::TransportContextId& context_id,
                               const qtransport::StreamId& streamId,
-                              messages::MessageBuffer&& msg)
+                              messages::MessageBufferView&& msg)
 {
   messages::Subscribe subscribe;
-  msg >> subscribe;
+  if (messages::try_decode(msg, subscribe) != messages::DecodeStatus::Ok)
+    return;
 
-  std::lock_guard<std::mutex> lock(mutex);
+  SubscribeContext context;
+  {
+    std::lock_guard<std::shared_mutex> lock(mutex);
 
-  if (subscribe_state[subscribe.quicr_namespace].count(context_id) == 0) {
+    if (subscribe_state[subscribe.quicr_namespace].count(context_id) == 0) {
 
-    SubscribeContext context;
-    context.transport_context_id = context_id;
-    context.transport_stream_id = streamId;
-    context.subscriber_id = subscriber_id;
+      context.transport_context_id = context_id;
+      context.transport_stream_id = streamId;
+      context.subscriber_id = subscriber_id;
 
-    subscriber_id++;
+      subscriber_id++;
 
-    subscribe_state[subscribe.quicr_namespace][context_id] = context;
-    subscribe_id_state[context.subscriber_id] = context;
-  }
+      subscribe_state[subscribe.quicr_namespace][context_id] = context;
+      subscribe_id_state[context.subscriber_id] = context;
+    }
 
-  auto& context = subscribe_state[subscribe.quicr_namespace][context_id];
+    // The delegate may respond from the callback, so call it unlocked
+    context = subscribe_state[subscribe.quicr_namespace][context_id];
+  }
 
   delegate.onSubscribe(subscribe.quicr_namespace,
                        context.subscriber_id,
@@ -246,77 +693,118 @@ void
 QuicRServer::handle_unsubscribe(
   const qtransport::TransportContextId& context_id,
   const qtransport::StreamId& /* streamId */,
-  messages::MessageBuffer&& msg)
+  messages::MessageBufferView&& msg)
 {
   messages::Unsubscribe unsub;
-  msg >> unsub;
+  if (messages::try_decode(msg, unsub) != messages::DecodeStatus::Ok)
+    return;
 
   // Remove states if state exists
-  if (subscribe_state[unsub.quicr_namespace].count(context_id) != 0) {
+  std::unique_lock<std::shared_mutex> lock(mutex);
 
-    std::lock_guard<std::mutex> lock(mutex);
+  auto subscribers = subscribe_state.find(unsub.quicr_namespace);
+  if (subscribers == subscribe_state.end() ||
+      subscribers->second.count(context_id) == 0) {
+    return;
+  }
 
-    auto& context = subscribe_state[unsub.quicr_namespace][context_id];
+  const auto context = subscribers->second[context_id];
 
-    // Before removing, exec callback
-    delegate.onUnsubscribe(unsub.quicr_namespace, context.subscriber_id, {});
+  subscribe_id_state.erase(context.subscriber_id);
+  subscribers->second.erase(context_id);
 
+  if (subscribers->second.empty()) {
+    subscribe_state.erase(subscribers);
+  }
 
-    subscribe_id_state.erase(context.subscriber_id);
-    subscribe_state[unsub.quicr_namespace].erase(context_id);
+  lock.unlock();
 
-    if (subscribe_state[unsub.quicr_namespace].size() > 0) {
-      subscribe_state.erase(unsub.quicr_namespace);
-    }
-  }
+  delegate.onUnsubscribe(unsub.quicr_namespace, context.subscriber_id, {});
 }
 
 void
-QuicRServer::handle_publish(const qtransport::TransportContextId& context_id,
+QuicRServer::handle_publish(PublishShard& shard,
+                            const qtransport::TransportContextId& context_id,
                             const qtransport::StreamId& streamId,
-                            messages::MessageBuffer&& msg)
+                            messages::MessageBufferView&& msg)
 {
-  messages::PublishDatagram datagram;
-  msg >> datagram;
+  // Only the header is decoded, the payload is passed on as received
+  messages::Header header;
+  if (messages::try_peek_publish_header(msg.data(), header) !=
+      messages::DecodeStatus::Ok)
+    return;
 
-  auto publish_namespace =
-    std::find_if(publish_namespaces.begin(),
-                 publish_namespaces.end(),
-                 [&datagram](const auto& ns) {
-                   return ns.first.contains(datagram.header.name);
-                 });
+  handle_publish_object(shard, context_id, streamId, header, msg.data());
+}
 
-  if (publish_namespace == publish_namespaces.end()) {
-    // No such namespace, don't publish yet.
-    return;
-  }
+void
+QuicRServer::handle_publish_fragment(
+  PublishShard& shard,
+  const qtransport::TransportContextId& context_id,
+  const qtransport::StreamId& streamId,
+  messages::PublishDatagramView&& fragment)
+{
+  // Fragments are cut from the stream by the decoder, so encode them as the
+  // datagrams they would be sent as
+  messages::MessageBuffer msg{ messages::wire_size(fragment), buffer_pool };
+  msg << fragment;
 
-  PublishContext context;
-  if (!publish_state.count(datagram.header.name)) {
-    context.transport_context_id = context_id;
-    context.transport_stream_id = streamId;
+  handle_publish_object(
+    shard, context_id, streamId, fragment.header, msg.view().data());
+}
 
-    publish_state[datagram.header.name] = context;
-  } else {
-    context = publish_state[datagram.header.name];
+void
+QuicRServer::handle_publish_object(
+  PublishShard& shard,
+  const qtransport::TransportContextId& context_id,
+  const qtransport::StreamId& streamId,
+  const messages::Header& header,
+  std::span<const uint8_t> encoded)
+{
+  PublishContext* context;
+  {
+    // A name is listed under its intents in the same hold as the check, so an
+    // intent that ends meanwhile either lists it, or keeps it out
+    std::shared_lock<std::shared_mutex> lock(publish_namespaces_mutex);
+    if (!publish_namespaces.matches(header.name)) {
+      // No such namespace, don't publish yet.
+      return;
+    }
+
+    bool inserted;
+    std::tie(context, inserted) =
+      shard.publish_state.try_emplace(header.name);
+    if (inserted) {
+      context->transport_context_id = context_id;
+      context->transport_stream_id = streamId;
+
+      std::as_const(publish_namespaces)
+        .for_each_match(header.name, [&](const Namespace& ns, const auto&) {
+          shard.intent_names[ns].insert(header.name);
+        });
+    }
   }
 
-  delegate.onPublisherObject(context.transport_context_id,
-                             context.transport_stream_id,
-                             false,
-                             std::move(datagram));
+  delegate.onPublisherObjectBytes(context->transport_context_id,
+                                  context->transport_stream_id,
+                                  false,
+                                  header,
+                                  encoded);
 }
 
 void
 QuicRServer::handle_publish_intent(
   const qtransport::TransportContextId& context_id,
   const qtransport::StreamId& streamId,
-  messages::MessageBuffer&& msg)
+  messages::MessageBufferView&& msg)
 {
   messages::PublishIntent intent;
-  msg >> intent;
+  if (messages::try_decode(msg, intent) != messages::DecodeStatus::Ok)
+    return;
 
-  if (!publish_namespaces.count(intent.quicr_namespace)) {
+  std::unique_lock<std::shared_mutex> lock(publish_namespaces_mutex);
+  if (auto existing = publish_namespaces.find(intent.quicr_namespace);
+      !existing) {
     PublishIntentContext context;
     context.state = PublishIntentContext::State::Pending;
     context.transport_context_id = context_id;
@@ -325,7 +813,7 @@ QuicRServer::handle_publish_intent(
 
     publish_namespaces[intent.quicr_namespace] = context;
   } else {
-    auto state = publish_namespaces[intent.quicr_namespace].state;
+    auto state = existing->state;
     switch (state) {
       case PublishIntentContext::State::Pending:
         // TODO: Resend response?
@@ -338,6 +826,9 @@ QuicRServer::handle_publish_intent(
     }
   }
 
+  // The delegate may respond from the callback, so call it unlocked
+  lock.unlock();
+
   delegate.onPublishIntent(intent.quicr_namespace,
                            "" /* intent.origin_url */,
                            false,
@@ -347,34 +838,72 @@ QuicRServer::handle_publish_intent(
 
 void
 QuicRServer::handle_publish_intent_end(
+  PublishShard& shard,
   [[maybe_unused]] const qtransport::TransportContextId& context_id,
   [[maybe_unused]] const qtransport::StreamId& streamId,
-  messages::MessageBuffer&& msg)
+  messages::MessageBufferView&& msg)
 {
   messages::PublishIntentEnd intent_end;
-  msg >> intent_end;
-
-  const auto& name = intent_end.quicr_namespace;
-
-  if (!publish_namespaces.count(intent_end.quicr_namespace)) {
+  if (messages::try_decode(msg, intent_end) != messages::DecodeStatus::Ok)
     return;
-  }
 
-  publish_namespaces.erase(name);
-
-  for (auto it = publish_state.begin(); it != publish_state.end();) {
-    const auto& [name, _] = *it;
-    if (intent_end.quicr_namespace.contains(name))
-      it = publish_state.erase(it);
-    else
-      ++it;
+  {
+    std::lock_guard<std::shared_mutex> lock(publish_namespaces_mutex);
+    if (!publish_namespaces.erase(intent_end.quicr_namespace)) {
+      return;
+    }
   }
 
+  end_publish_intent(shard, intent_end.quicr_namespace);
+
   delegate.onPublishIntentEnd(intent_end.quicr_namespace,
                               "" /* intent_end.relay_token */,
                               std::move(intent_end.payload));
 }
 
+void
+QuicRServer::handle(PublishShard& shard,
+                    const qtransport::TransportContextId& context_id,
+                    const qtransport::StreamId& streamId,
+                    messages::MessageBufferView&& msg)
+{
+  if (msg.empty())
+    return;
+
+  // TODO: Extracting type will change when the message is encoded
+  // correctly
+  auto msg_type = static_cast<messages::MessageType>(msg.front());
+
+  switch (msg_type) {
+    case messages::MessageType::Subscribe:
+      handle_subscribe(context_id, streamId, std::move(msg));
+      break;
+    case messages::MessageType::Publish:
+      handle_publish(shard, context_id, streamId, std::move(msg));
+      break;
+    case messages::MessageType::Unsubscribe:
+      handle_unsubscribe(context_id, streamId, std::move(msg));
+      break;
+    case messages::MessageType::PublishIntent: {
+      handle_publish_intent(context_id, streamId, std::move(msg));
+      break;
+    }
+    case messages::MessageType::PublishIntentEnd: {
+      handle_publish_intent_end(shard, context_id, streamId, std::move(msg));
+      break;
+    }
+    case messages::MessageType::Batch: {
+      messages::for_each_batched(
+        msg.data(), [&](messages::MessageBufferView&& message) {
+          handle(shard, context_id, streamId, std::move(message));
+        });
+      break;
+    }
+    default:
+      break;
+  }
+}
+
 /*===========================================================================*/
 // Transport Delegate Implementation
 /*===========================================================================*/
@@ -399,29 +928,48 @@ QuicRServer::TransportDelegate::on_connection_status(
     log_msg << "Removing state for context_id: " << context_id;
     server.log_handler.log(qtransport::LogLevel::info, log_msg.str());
 
-    std::lock_guard<std::mutex> lock(server.mutex);
-
-    std::vector<quicr::Namespace> namespaces_to_remove;
-    for (auto& sub: server.subscribe_state) {
-      if (sub.second.count(context_id) != 0) {
-
-
-        const auto& stream_id = sub.second[context_id].subscriber_id;
+    std::vector<std::pair<quicr::Namespace, uint64_t>> removed;
+    {
+      std::lock_guard<std::shared_mutex> lock(server.mutex);
+
+      for (auto it = server.subscribe_state.begin();
+           it != server.subscribe_state.end();) {
+        auto& [ns, subscribers] = *it;
+        auto subscriber = subscribers.find(context_id);
+        if (subscriber != subscribers.end()) {
+          removed.emplace_back(ns, subscriber->second.subscriber_id);
+          server.subscribe_id_state.erase(subscriber->second.subscriber_id);
+          subscribers.erase(subscriber);
+        }
 
-        // Before removing, exec callback
-        server.delegate.onUnsubscribe(sub.first, stream_id, {});
+        if (subscribers.empty())
+          it = server.subscribe_state.erase(it);
+        else
+          ++it;
+      }
+    }
 
-        server.subscribe_id_state.erase(stream_id);
+    for (const auto& [ns, subscriber_id] : removed) {
+      server.delegate.onUnsubscribe(ns, subscriber_id, {});
+    }
 
-        if (sub.second.size() == 0) {
-          namespaces_to_remove.push_back(sub.first);
-        }
-      }
+    // Streams that carried the connection's objects to others are done
+    for (const auto& [dest_context_id, stream_id] :
+         server.object_streams.erase(context_id)) {
+      server.transport->closeStream(dest_context_id, stream_id);
+    }
 
-      for (const auto& ns: namespaces_to_remove) {
-          server.subscribe_state.erase(ns);
-      }
+    {
+      std::lock_guard<std::mutex> batch_lock(server.batch_mutex);
+      std::erase_if(server.pending_batches, [&context_id](const auto& entry) {
+        return entry.first.first == context_id;
+      });
     }
+
+    std::lock_guard<std::mutex> decoder_lock(server.stream_decoder_mutex);
+    std::erase_if(server.stream_decoders, [&context_id](const auto& entry) {
+      return entry.first.first == context_id;
+    });
   }
 
 }
@@ -446,6 +994,12 @@ QuicRServer::TransportDelegate::on_new_stream(
   log_msg << "new_stream: cid: " << context_id << " msid: " << streamId;
 
   server.log_handler.log(qtransport::LogLevel::debug, log_msg.str());
+
+  // The transport announces only reliable streams, which are framed
+  // incrementally. Datagrams are each handled whole
+  std::lock_guard<std::mutex> lock(server.stream_decoder_mutex);
+  server.stream_decoders.try_emplace(
+    { context_id, streamId }, std::make_shared<messages::StreamDecoder>());
 }
 
 void
@@ -453,57 +1007,12 @@ QuicRServer::TransportDelegate::on_recv_notify(
   const qtransport::TransportContextId& context_id,
   const qtransport::StreamId& streamId)
 {
-
-  // don't starve other queues, read some number of messages at a time
-  for (int i=0; i < 150; i++) {
-    auto data = server.transport->dequeue(context_id, streamId);
-
-    if (data.has_value()) {
-      try {
-        // TODO: Extracting type will change when the message is encoded
-        // correctly
-        auto msg_type = static_cast<messages::MessageType>(data->front());
-        messages::MessageBuffer msg_buffer{ data.value() };
-
-        switch (msg_type) {
-          case messages::MessageType::Subscribe:
-            server.handle_subscribe(
-              context_id, streamId, std::move(msg_buffer));
-            break;
-          case messages::MessageType::Publish:
-            server.handle_publish(context_id, streamId, std::move(msg_buffer));
-            break;
-          case messages::MessageType::Unsubscribe:
-            server.handle_unsubscribe(
-              context_id, streamId, std::move(msg_buffer));
-            break;
-          case messages::MessageType::PublishIntent: {
-            server.handle_publish_intent(
-              context_id, streamId, std::move(msg_buffer));
-            break;
-          }
-          case messages::MessageType::PublishIntentEnd: {
-            server.handle_publish_intent_end(
-              context_id, streamId, std::move(msg_buffer));
-            break;
-          }
-          default:
-            break;
-        }
-      } catch (const messages::MessageBuffer::ReadException& /* ex */) {
-        continue;
-      } catch (const std::exception& /* ex */) {
-        continue;
-      } catch (...) {
-        server.log_handler.log(
-          qtransport::LogLevel::fatal,
-          "Received unknown error while reading from message buffer.");
-        throw;
-      }
-    } else {
-      break;
-    }
+  if (!server.workers().empty()) {
+    server.dispatch(context_id, { context_id, streamId });
+    return;
   }
+
+  server.receive(server.publish_shard, context_id, streamId);
 }
 
 } /* namespace end */
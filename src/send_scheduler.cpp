@@ -0,0 +1,68 @@
+#include <quicr/send_scheduler.h>
+
+namespace quicr {
+
+void
+SendScheduler::push(uint8_t priority,
+                    uint16_t expiry_age_ms,
+                    const qtransport::StreamId& stream_id,
+                    std::vector<uint8_t>&& packet,
+                    bool flush_now,
+                    Clock::time_point now)
+{
+  _queues[priority].push_back({ stream_id,
+                                std::move(packet),
+                                deadline(expiry_age_ms, now),
+                                flush_now,
+                                true,
+                                true });
+  ++_size;
+}
+
+void
+SendScheduler::push_fragments(uint8_t priority,
+                              uint16_t expiry_age_ms,
+                              const qtransport::StreamId& stream_id,
+                              std::vector<std::vector<uint8_t>>&& packets,
+                              bool flush_now,
+                              Clock::time_point now)
+{
+  if (packets.empty())
+    return;
+
+  auto& queue = _queues[priority];
+  const auto object_deadline = deadline(expiry_age_ms, now);
+
+  for (size_t i = 0; i < packets.size(); ++i) {
+    queue.push_back({ stream_id,
+                      std::move(packets[i]),
+                      object_deadline,
+                      flush_now,
+                      i == 0,
+                      i == packets.size() - 1 });
+  }
+  _size += packets.size();
+}
+
+SendScheduler::Clock::time_point
+SendScheduler::deadline(uint16_t expiry_age_ms, Clock::time_point now)
+{
+  return expiry_age_ms ? now + std::chrono::milliseconds(expiry_age_ms)
+                       : Clock::time_point::max();
+}
+
+std::deque<SendScheduler::Entry>::iterator
+SendScheduler::expire(std::deque<Entry>& queue, std::deque<Entry>::iterator it)
+{
+  bool last;
+  do {
+    last = it->last;
+    it = queue.erase(it);
+    --_size;
+  } while (!last);
+
+  ++_expired;
+  return it;
+}
+
+}
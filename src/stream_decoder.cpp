@@ -0,0 +1,169 @@
+#include <quicr/stream_decoder.h>
+
+#include <algorithm>
+
+namespace quicr::messages {
+
+namespace {
+// Decodes, and discards, a message to find where it ends
+template<typename T>
+DecodeStatus
+skip(MessageBufferView& view)
+{
+  T msg;
+  return try_decode(view, msg);
+}
+}
+
+StreamDecoder::StreamDecoder(size_t max_fragment_size,
+                             uint64_t max_object_size)
+  : _max_fragment_size{ max_fragment_size }
+  , _max_object_size{ max_object_size }
+{
+}
+
+void
+StreamDecoder::reset()
+{
+  _pending.clear();
+  _input = {};
+  _input_is_pending = false;
+  _object.reset();
+}
+
+void
+StreamDecoder::begin(std::span<const uint8_t> chunk)
+{
+  if (_pending.empty()) {
+    _input = chunk;
+    _input_is_pending = false;
+    return;
+  }
+
+  // Join the chunk to the incomplete message it continues
+  _pending.insert(_pending.end(), chunk.begin(), chunk.end());
+  _input = _pending;
+  _input_is_pending = true;
+}
+
+void
+StreamDecoder::end()
+{
+  // Keep the bytes of an incomplete message for the next chunk
+  if (_input_is_pending) {
+    const auto consumed = _pending.size() - _input.size();
+    _pending.erase(_pending.begin(), _pending.begin() + consumed);
+  } else {
+    _pending.assign(_input.begin(), _input.end());
+  }
+
+  _input = {};
+  _input_is_pending = false;
+}
+
+DecodeStatus
+StreamDecoder::next(Frame& frame)
+{
+  frame.fragment.reset();
+
+  if (_input.empty())
+    return DecodeStatus::Truncated;
+
+  if (_object) {
+    const auto length = std::min<uint64_t>(
+      { _input.size(), _object->size - _object->offset, _max_fragment_size });
+
+    const uint64_t offset_and_fin = _object->header.offset_and_fin;
+    const uint64_t offset = (offset_and_fin >> 1) + _object->offset;
+
+    _object->offset += length;
+    const bool fin = (offset_and_fin & 0x1) && _object->offset == _object->size;
+
+    PublishDatagramView fragment;
+    fragment.header = _object->header;
+    fragment.header.offset_and_fin = (offset << 1) | (fin ? 0x1 : 0x0);
+    fragment.media_type = _object->media_type;
+    fragment.media_data_length = length;
+    fragment.media_data = _input.first(length);
+    frame.fragment = fragment;
+
+    _input = _input.subspan(length);
+    if (_object->offset == _object->size)
+      _object.reset();
+
+    return DecodeStatus::Ok;
+  }
+
+  MessageBufferView view{ _input };
+  auto status = DecodeStatus::Ok;
+
+  switch (static_cast<MessageType>(_input.front())) {
+    case MessageType::Publish: {
+      uint8_t msg_type;
+      Header header;
+      uint8_t media_type;
+      uintVar_t media_data_length;
+      uintVar_t payload_size;
+      status = try_decode_fields(
+        view, msg_type, header, media_type, media_data_length, payload_size);
+      if (status != DecodeStatus::Ok)
+        return status;
+
+      if (media_data_length != payload_size ||
+          static_cast<uint64_t>(payload_size) > _max_object_size)
+        return DecodeStatus::InvalidLength;
+
+      if (view.size() >= payload_size) {
+        view.pop(payload_size);
+        break;
+      }
+
+      // Read the payload as it arrives, rather than waiting for all of it
+      _object = Object{
+        header, static_cast<MediaType>(media_type), payload_size, 0
+      };
+      _input = view.data();
+      return next(frame);
+    }
+    case MessageType::Batch: {
+      uint8_t msg_type;
+      std::span<const uint8_t> messages;
+      status = try_decode_fields(view, msg_type, messages);
+      break;
+    }
+    case MessageType::Subscribe:
+      status = skip<Subscribe>(view);
+      break;
+    case MessageType::SubscribeResponse:
+      status = skip<SubscribeResponse>(view);
+      break;
+    case MessageType::SubscribeEnd:
+      status = skip<SubscribeEnd>(view);
+      break;
+    case MessageType::Unsubscribe:
+      status = skip<Unsubscribe>(view);
+      break;
+    case MessageType::PublishIntent:
+      status = skip<PublishIntent>(view);
+      break;
+    case MessageType::PublishIntentResponse:
+      status = skip<PublishIntentResponse>(view);
+      break;
+    case MessageType::PublishIntentEnd:
+      status = skip<PublishIntentEnd>(view);
+      break;
+    default:
+      return DecodeStatus::InvalidType;
+  }
+
+  if (status != DecodeStatus::Ok)
+    return status;
+
+  const auto length = _input.size() - view.size();
+  frame.message = _input.first(length);
+  _input = _input.subspan(length);
+
+  return DecodeStatus::Ok;
+}
+
+}
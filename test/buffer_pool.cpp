@@ -0,0 +1,147 @@
+#include <doctest/doctest.h>
+
+#include <quicr/buffer_pool.h>
+#include <quicr/message_buffer.h>
+#include <quicr/mpmc_queue.h>
+
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace quicr;
+using namespace quicr::messages;
+
+TEST_CASE("BufferPool Acquire Size Classes")
+{
+  BufferPool pool;
+
+  auto small = pool.acquire(10);
+  CHECK(small.empty());
+  CHECK_GE(small.capacity(), 256);
+
+  auto datagram = pool.acquire(1200);
+  CHECK_GE(datagram.capacity(), 1536);
+
+  auto large = pool.acquire(100000);
+  CHECK_GE(large.capacity(), 100000);
+}
+
+TEST_CASE("BufferPool Recycle")
+{
+  BufferPool pool;
+
+  auto buffer = pool.acquire(1200);
+  buffer.resize(1200);
+  const auto* data = buffer.data();
+  pool.release(std::move(buffer));
+
+  auto recycled = pool.acquire(1000);
+  CHECK_EQ(recycled.data(), data);
+  CHECK(recycled.empty());
+
+  // Oversized buffers are not kept
+  std::vector<uint8_t> oversized;
+  oversized.reserve(1 << 20);
+  pool.release(std::move(oversized));
+  auto fresh = pool.acquire(65536);
+  CHECK_LT(fresh.capacity(), 1 << 20);
+}
+
+TEST_CASE("BufferRelease Returns Storage When Unwinding")
+{
+  BufferPool pool;
+
+  auto buffer = pool.acquire(1200);
+  const auto* data = buffer.data();
+
+  try {
+    const BufferRelease release{ pool, buffer };
+    throw std::runtime_error("Decode failed");
+  } catch (const std::runtime_error&) {
+  }
+
+  CHECK_EQ(pool.acquire(1200).data(), data);
+}
+
+TEST_CASE("MessageBuffer Returns Storage To Pool")
+{
+  BufferPool pool;
+  const uint8_t* data = nullptr;
+
+  {
+    MessageBuffer buffer{ 100, pool };
+    buffer << uint64_t(1);
+    data = buffer.view().data().data();
+  }
+  CHECK_EQ(pool.acquire(100).data(), data);
+
+  // Storage moved out for sending belongs to the caller
+  MessageBuffer buffer{ 100, pool };
+  buffer << uint64_t(1);
+  data = buffer.view().data().data();
+  CHECK_EQ(buffer.get().data(), data);
+}
+
+TEST_CASE("MessageBuffer Copies Do Not Return Storage To Pool")
+{
+  BufferPool pool;
+  MessageBuffer original{ 300, pool };
+  for (int i = 0; i < 300; ++i)
+    original << uint8_t(i);
+
+  const uint8_t* copy_data = nullptr;
+  {
+    MessageBuffer copy{ original };
+    copy_data = copy.view().data().data();
+  }
+  const auto next = pool.acquire(100);
+  CHECK_NE(next.data(), copy_data);
+
+  // Assigning a copy gives the pooled storage it replaces back
+  const uint8_t* pooled_data = nullptr;
+  {
+    MessageBuffer assigned{ 100, pool };
+    assigned << uint8_t(1);
+    pooled_data = assigned.view().data().data();
+
+    assigned = original;
+    CHECK_EQ(assigned.size(), 300);
+  }
+  CHECK_EQ(pool.acquire(100).data(), pooled_data);
+  CHECK_EQ(original.size(), 300);
+}
+
+TEST_CASE("MPMCQueue Concurrent Push Pop")
+{
+  MPMCQueue<int> queue(100);
+  CHECK_EQ(queue.capacity(), 128);
+
+  constexpr int per_thread = 10000;
+  std::vector<std::thread> producers;
+  for (int t = 0; t < 4; ++t) {
+    producers.emplace_back([&queue] {
+      for (int i = 1; i <= per_thread; ++i) {
+        int value = i;
+        while (!queue.try_push(std::move(value)))
+          std::this_thread::yield();
+      }
+    });
+  }
+
+  long long sum = 0;
+  for (int popped = 0; popped < 4 * per_thread;) {
+    int value;
+    if (queue.try_pop(value)) {
+      sum += value;
+      ++popped;
+    }
+  }
+
+  for (auto& producer : producers)
+    producer.join();
+
+  CHECK_EQ(sum, 4LL * per_thread * (per_thread + 1) / 2);
+
+  int value;
+  CHECK_FALSE(queue.try_pop(value));
+}
@@ -15,6 +15,43 @@ TEST_CASE("MessageBuffer Decode Exception")
   CHECK_THROWS((buffer >> out));
 }
 
+TEST_CASE("MessageBuffer Read Offset")
+{
+  MessageBuffer buffer;
+  buffer << uint8_t(0x01) << uint16_t(0x0203) << uint8_t(0x04);
+  CHECK_EQ(buffer.size(), 4);
+
+  uint8_t first;
+  buffer >> first;
+  CHECK_EQ(first, 0x01);
+  CHECK_EQ(buffer.size(), 3);
+  CHECK_EQ(buffer.front(), 0x02);
+  CHECK_EQ(buffer.to_hex(), "020304");
+
+  CHECK_EQ(buffer.get(), std::vector<uint8_t>{ 0x02, 0x03, 0x04 });
+}
+
+TEST_CASE("MessageBuffer Move Resets Read Offset")
+{
+  MessageBuffer buffer;
+  buffer << uint8_t(0x01) << uint8_t(0x02);
+
+  uint8_t first;
+  buffer >> first;
+
+  MessageBuffer moved{ std::move(buffer) };
+  CHECK_EQ(moved.size(), 1);
+  CHECK_EQ(moved.front(), 0x02);
+  CHECK(buffer.empty());
+  CHECK_EQ(buffer.size(), 0);
+
+  MessageBuffer assigned;
+  assigned = std::move(moved);
+  CHECK_EQ(assigned.size(), 1);
+  CHECK(moved.empty());
+  CHECK_EQ(moved.size(), 0);
+}
+
 /*===========================================================================*/
 // Subscribe Message Types
 /*===========================================================================*/
@@ -147,6 +184,141 @@ TEST_CASE("Publish Message encode/decode")
   CHECK_EQ(p_out.media_data, data);
 }
 
+TEST_CASE("Publish Message decode from view")
+{
+  quicr::Name qn = 0x10000000000000002000_name;
+  Header d{ uintVar_t{ 0x1000 }, qn,
+            uintVar_t{ 0x0100 }, uintVar_t{ 0x0010 },
+            uintVar_t{ 0x0001 }, 0x0000 };
+
+  std::vector<uint8_t> data(256);
+  for (int i = 0; i < 256; ++i)
+    data[i] = i;
+
+  PublishDatagram p{ d, MediaType::Text, uintVar_t{ 256 }, data };
+  MessageBuffer buffer;
+  buffer << p;
+  const auto packet = buffer.get();
+
+  MessageBufferView view{ packet };
+  PublishDatagramView p_out;
+  CHECK_NOTHROW((view >> p_out));
+  CHECK(view.empty());
+
+  CHECK_EQ(p_out.header.name, qn);
+  CHECK_EQ(p_out.header.group_id, p.header.group_id);
+  CHECK_EQ(p_out.media_data_length, p.media_data_length);
+  CHECK_EQ(p_out.media_data.data(), packet.data() + packet.size() - 256);
+  CHECK(std::equal(
+    p_out.media_data.begin(), p_out.media_data.end(), data.begin(), data.end()));
+
+  MessageBufferView truncated{ std::span(packet).first(packet.size() - 1) };
+  CHECK_THROWS((truncated >> p_out));
+}
+
+TEST_CASE("Publish Message encode segments")
+{
+  quicr::Name qn = 0x10000000000000002000_name;
+  Header d{ uintVar_t{ 0x1000 }, qn,
+            uintVar_t{ 0x0100 }, uintVar_t{ 0x0010 },
+            uintVar_t{ 0x0001 }, 0x0000 };
+
+  std::vector<uint8_t> data(256);
+  for (int i = 0; i < 256; ++i)
+    data[i] = i;
+
+  PublishDatagram p{ d, MediaType::Text, uintVar_t{ 256 }, data };
+  MessageBuffer buffer;
+  buffer << p;
+  const auto packet = buffer.get();
+
+  PublishDatagramView v{ d, MediaType::Text, uintVar_t{ 256 }, data };
+  auto segments = encode_segments(v);
+  CHECK_EQ(segments.payload.data(), data.data());
+  CHECK_EQ(segments.header.size(), packet.size() - data.size());
+  CHECK_EQ(segments.size(), packet.size());
+  CHECK_EQ(std::move(segments).gather(), packet);
+
+  MessageBuffer view_buffer;
+  view_buffer << v;
+  CHECK_EQ(view_buffer.get(), packet);
+}
+
+TEST_CASE("Publish Message try_decode status")
+{
+  quicr::Name qn = 0x10000000000000002000_name;
+  Header d{ uintVar_t{ 0x1000 }, qn,
+            uintVar_t{ 0x0100 }, uintVar_t{ 0x0010 },
+            uintVar_t{ 0x0001 }, 0x0000 };
+
+  PublishDatagram p{ d, MediaType::Text, uintVar_t{ 256 }, bytes(256) };
+  MessageBuffer buffer;
+  buffer << p;
+  auto packet = buffer.get();
+
+  MessageBufferView view{ packet };
+  PublishDatagramView p_out;
+  CHECK_EQ(try_decode(view, p_out), DecodeStatus::Ok);
+  CHECK(view.empty());
+  CHECK_EQ(p_out.header.name, qn);
+
+  for (size_t size : { size_t(0), size_t(1), size_t(10), packet.size() - 1 }) {
+    MessageBufferView truncated{ std::span(packet).first(size) };
+    CHECK_EQ(try_decode(truncated, p_out), DecodeStatus::Truncated);
+  }
+
+  auto wrong_type = packet;
+  wrong_type[0] = static_cast<uint8_t>(MessageType::Subscribe);
+  MessageBufferView wrong_type_view{ wrong_type };
+  CHECK_EQ(try_decode(wrong_type_view, p_out), DecodeStatus::InvalidType);
+
+  PublishDatagram bad_length{ d, MediaType::Text, uintVar_t{ 255 }, bytes(256) };
+  buffer << bad_length;
+  auto bad_length_packet = buffer.get();
+  MessageBufferView bad_length_view{ bad_length_packet };
+  CHECK_EQ(try_decode(bad_length_view, p_out), DecodeStatus::InvalidLength);
+
+  // The throwing API reports the same failures as exceptions
+  MessageBufferView truncated{ std::span(packet).first(10) };
+  CHECK_THROWS_AS((truncated >> p_out), MessageBuffer::ReadException);
+  wrong_type_view = MessageBufferView{ wrong_type };
+  CHECK_THROWS_AS((wrong_type_view >> p_out),
+                  MessageBuffer::MessageTypeException);
+  bad_length_view = MessageBufferView{ bad_length_packet };
+  CHECK_THROWS_AS((bad_length_view >> p_out), MessageBuffer::LengthException);
+}
+
+TEST_CASE("Publish Message peek header")
+{
+  quicr::Name qn = 0x10000000000000002000_name;
+  Header d{ uintVar_t{ 0x1000 }, qn,
+            uintVar_t{ 0x0100 }, uintVar_t{ 0x0010 },
+            uintVar_t{ 0x0001 }, 0x0000 };
+
+  PublishDatagram p{ d, MediaType::Text, uintVar_t{ 256 }, bytes(256) };
+  MessageBuffer buffer;
+  buffer << p;
+  const auto packet = buffer.get();
+
+  // Payload is not needed to read the header
+  const auto header_size = 1 + wire_size(d);
+  Header h{};
+  CHECK_NOTHROW(h = peek_publish_header(std::span(packet).first(header_size)));
+  CHECK_EQ(h.name, qn);
+  CHECK_EQ(h.media_id, d.media_id);
+  CHECK_EQ(h.group_id, d.group_id);
+  CHECK_EQ(h.object_id, d.object_id);
+  CHECK_EQ(h.offset_and_fin, d.offset_and_fin);
+
+  CHECK_THROWS_AS(peek_publish_header(std::span(packet).first(header_size - 1)),
+                  MessageBuffer::ReadException);
+
+  MessageBuffer intent;
+  intent << PublishIntentEnd{ MessageType::PublishIntentEnd, {}, {} };
+  CHECK_THROWS_AS(peek_publish_header(intent.get()),
+                  MessageBuffer::MessageTypeException);
+}
+
 TEST_CASE("PublishStream Message encode/decode")
 {
   PublishStream ps{ uintVar_t{ 5 }, { 0, 1, 2, 3, 4 } };
@@ -176,6 +348,149 @@ TEST_CASE("PublishIntentEnd Message encode/decode")
   CHECK_EQ(pie_out.payload, pie.payload);
 }
 
+TEST_CASE("MessageBatch encode/split")
+{
+  quicr::Namespace qnamespace{ 0x10000000000000002000_name, 125 };
+  Subscribe s{ 1, 0x1000, qnamespace, SubscribeIntent::immediate };
+  Unsubscribe us{ .version = 0x1, .quicr_namespace = qnamespace };
+
+  MessageBuffer s_buffer;
+  s_buffer << s;
+  MessageBuffer us_buffer;
+  us_buffer << us;
+
+  MessageBatch batch{ 64 };
+  CHECK(batch.empty());
+  CHECK(batch.fits(wire_size(s)));
+  batch.append(s_buffer.get());
+  CHECK(batch.fits(wire_size(us)));
+  batch.append(us_buffer.get());
+  CHECK_EQ(batch.count(), 2);
+  CHECK_FALSE(batch.fits(64));
+
+  const auto batch_size = batch.size();
+  const auto packet = batch.flush();
+  CHECK(batch.empty());
+  CHECK_EQ(packet.size(), batch_size);
+  CHECK_EQ(packet.size(), 1 + 1 + 1 + wire_size(s) + 1 + wire_size(us));
+  CHECK_EQ(packet[0], static_cast<uint8_t>(MessageType::Batch));
+  CHECK_EQ(packet[1], packet.size() - 2);
+
+  size_t count = 0;
+  auto status = for_each_batched(packet, [&](MessageBufferView&& msg) {
+    if (count++ == 0) {
+      Subscribe s_out;
+      CHECK_EQ(try_decode(msg, s_out), DecodeStatus::Ok);
+      CHECK_EQ(s_out.transaction_id, s.transaction_id);
+    } else {
+      Unsubscribe us_out;
+      CHECK_EQ(try_decode(msg, us_out), DecodeStatus::Ok);
+      CHECK_EQ(us_out.quicr_namespace, qnamespace);
+    }
+    CHECK(msg.empty());
+  });
+  CHECK_EQ(status, DecodeStatus::Ok);
+  CHECK_EQ(count, 2);
+
+  const auto truncated = std::span(packet).first(packet.size() - 1);
+  CHECK_EQ(for_each_batched(truncated, [](auto&&) {}), DecodeStatus::Truncated);
+
+  auto trailing = packet;
+  trailing.push_back(0x00);
+  CHECK_EQ(for_each_batched(trailing, [](auto&&) {}),
+           DecodeStatus::InvalidLength);
+
+  MessageBatch nested;
+  nested.append(packet);
+  CHECK_EQ(for_each_batched(nested.flush(), [](auto&&) {}),
+           DecodeStatus::InvalidType);
+}
+
+TEST_CASE("Message wire_size matches encoded size")
+{
+  auto encoded_size = [](const auto& msg) {
+    MessageBuffer buffer;
+    buffer << msg;
+    return buffer.size();
+  };
+
+  quicr::Namespace qnamespace{ 0x10000000000000002000_name, 125 };
+
+  Subscribe s{ 1, 0x1000, qnamespace, SubscribeIntent::immediate };
+  CHECK_EQ(wire_size(s), encoded_size(s));
+
+  Unsubscribe us{ .version = 0x1, .quicr_namespace = qnamespace };
+  CHECK_EQ(wire_size(us), encoded_size(us));
+
+  SubscribeResponse sr{ qnamespace, SubscribeResult::SubscribeStatus::Ok, 1 };
+  CHECK_EQ(wire_size(sr), encoded_size(sr));
+
+  SubscribeEnd se{ qnamespace, SubscribeResult::SubscribeStatus::Ok };
+  CHECK_EQ(wire_size(se), encoded_size(se));
+
+  PublishIntent pi{ MessageType::PublishIntent, 0x1000,
+                    qnamespace,                 std::vector<uint8_t>(300),
+                    uintVar_t{ 0x4000 },        uintVar_t{ 1 } };
+  CHECK_EQ(wire_size(pi), encoded_size(pi));
+
+  PublishIntentResponse pir{ MessageType::Publish, {}, Response::Ok, 0x1000 };
+  CHECK_EQ(wire_size(pir), encoded_size(pir));
+
+  PublishIntentEnd pie{ MessageType::PublishIntentEnd, qnamespace, {} };
+  CHECK_EQ(wire_size(pie), encoded_size(pie));
+
+  // Cover every varint size class across the header and payload lengths
+  for (uint64_t value : { 0x3F, 0x3FFF, 0x1FFFFFFF, 0x20000000 }) {
+    Header h{ uintVar_t{ value },    0x10000000000000002000_name,
+              uintVar_t{ value },    uintVar_t{ value >> 8 },
+              uintVar_t{ value << 1 }, 0x0000 };
+    CHECK_EQ(wire_size(h), encoded_size(h));
+
+    const uint64_t length = std::min<uint64_t>(value, 20000);
+    PublishDatagram p{
+      h, MediaType::Text, uintVar_t{ length }, std::vector<uint8_t>(length)
+    };
+    CHECK_EQ(wire_size(p), encoded_size(p));
+
+    PublishStream ps{ uintVar_t{ length }, std::vector<uint8_t>(length) };
+    CHECK_EQ(wire_size(ps), encoded_size(ps));
+  }
+}
+
+TEST_CASE("Message layout wire bytes")
+{
+  quicr::Namespace qnamespace{ 0x10000000000000002000_name, 120 };
+  Subscribe s{ 1, 0x0102030405060708, qnamespace, SubscribeIntent::wait_up };
+
+  MessageBuffer buffer;
+  buffer << s;
+
+  // clang-format off
+  const std::vector<uint8_t> expected{
+    static_cast<uint8_t>(MessageType::Subscribe),
+    0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0x00,
+    120,
+    static_cast<uint8_t>(SubscribeIntent::wait_up),
+  };
+  // clang-format on
+  CHECK_EQ(buffer.get(), expected);
+
+  // A decode stops at the end of its message, leaving what follows
+  buffer << s;
+  buffer.push(0xFF);
+  auto packet = buffer.get();
+  MessageBufferView view{ packet };
+
+  Subscribe s_out;
+  CHECK_EQ(try_decode(view, s_out), DecodeStatus::Ok);
+  CHECK_EQ(s_out.transaction_id, s.transaction_id);
+  CHECK_EQ(s_out.quicr_namespace, qnamespace);
+  CHECK_EQ(s_out.intent, s.intent);
+  CHECK_EQ(view.size(), 1);
+}
+
 TEST_CASE("VarInt Encode/Decode")
 {
   MessageBuffer buffer;
@@ -190,3 +505,47 @@ TEST_CASE("VarInt Encode/Decode")
     CHECK_NE(out, uintVar_t{ 0 });
   }
 }
+
+TEST_CASE("VarInt Size Classes")
+{
+  const std::vector<std::pair<uint64_t, size_t>> values = {
+    { 0, 1 },          { 127, 1 },         { 128, 2 },
+    { 16383, 2 },      { 16384, 4 },       { 536870911, 4 },
+    { 536870912, 8 },  { (1ull << 60) - 1, 8 }
+  };
+
+  for (const auto& [value, size] : values) {
+    MessageBuffer buffer;
+    buffer << uintVar_t{ value };
+    CHECK_EQ(buffer.size(), size);
+    CHECK_EQ(quicr::varint::length(buffer.front()), size);
+
+    uintVar_t out;
+    buffer >> out;
+    CHECK_EQ(uint64_t(out), value);
+    CHECK(buffer.empty());
+  }
+}
+
+TEST_CASE("VarInt Batch Encode")
+{
+  const std::array<uintVar_t, 4> values = { uintVar_t{ 1 },
+                                            uintVar_t{ 0x1000 },
+                                            uintVar_t{ 0x100000 },
+                                            uintVar_t{ 0x100000000 } };
+
+  MessageBuffer one_by_one;
+  for (const auto& value : values)
+    one_by_one << value;
+
+  MessageBuffer batch;
+  batch << std::span<const uintVar_t>(values);
+  CHECK_EQ(batch.size(), quicr::varint::size(values));
+  CHECK_EQ(batch.to_hex(), one_by_one.to_hex());
+
+  for (const auto& value : values) {
+    uintVar_t out;
+    batch >> out;
+    CHECK_EQ(out, value);
+  }
+}
@@ -1,6 +1,8 @@
 #pragma once
 #include <transport/transport.h>
 
+#include <atomic>
+
 using namespace qtransport;
 
 struct FakeTransportDelegate : public ITransport::TransportDelegate
@@ -38,9 +40,10 @@ struct FakeTransport : public ITransport
   TransportStatus status() const { return TransportStatus::Ready; }
 
   StreamId createStream(const TransportContextId& /* tcid */,
-                        bool /* use_reliable_transport */)
+                        bool use_reliable_transport)
   {
-    return 0x2000;
+    reliable_streams.push_back(use_reliable_transport);
+    return 0x2000 + reliable_streams.size() - 1;
   }
 
   void close(const TransportContextId& /* context_id */){};
@@ -50,10 +53,17 @@ struct FakeTransport : public ITransport
   void close() {}
 
   TransportError enqueue(const TransportContextId& /* tcid */,
-                         const StreamId& /* sid */,
+                         const StreamId& sid,
                          std::vector<uint8_t>&& bytes)
   {
+    // Decline the bytes, as a congested transport would
+    if (queue_full)
+      return TransportError::QueueFull;
+
     stored_data = std::move(bytes);
+    sent.push_back(stored_data);
+    sent_streams.push_back(sid);
+    ++sent_count;
     return TransportError::None;
   }
 
@@ -64,4 +74,13 @@ struct FakeTransport : public ITransport
   }
 
   std::vector<uint8_t> stored_data;
+  std::vector<std::vector<uint8_t>> sent;
+  std::vector<StreamId> sent_streams;
+
+  // Reliability of each stream created, by stream id from 0x2000
+  std::vector<bool> reliable_streams;
+
+  // Shared with the client's retry thread
+  std::atomic<bool> queue_full{ false };
+  std::atomic<size_t> sent_count{ 0 };
 };
\ No newline at end of file
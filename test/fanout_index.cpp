@@ -0,0 +1,109 @@
+#include <doctest/doctest.h>
+
+#include <quicr/fanout_index.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace {
+std::vector<int>
+subscribers(const quicr::FanoutIndex<int>& index, const quicr::Name& name)
+{
+  std::vector<int> found;
+  index.for_each(name, [&](int subscriber) { found.push_back(subscriber); });
+  return found;
+}
+}
+
+TEST_CASE("quicr::FanoutIndex Add/Erase Test")
+{
+  quicr::FanoutIndex<int> index;
+  const quicr::Name name = 0x11111111111111112222222222222233_name;
+  const quicr::Namespace wide{ name, 64 };
+  const quicr::Namespace narrow{ name, 120 };
+
+  CHECK(subscribers(index, name).empty());
+  CHECK_FALSE(index.find(wide));
+
+  index.add(wide, 1);
+  index.add(narrow, 2);
+  index.add(narrow, 3);
+  CHECK_EQ(subscribers(index, name), std::vector<int>{ 1, 2, 3 });
+  CHECK_EQ(subscribers(index, 0x111111111111111122222222222233FF_name),
+           std::vector<int>{ 1 });
+
+  // Snapshots are not changed by later changes
+  const auto before = index.find(narrow);
+  CHECK_EQ(
+    index.erase_if(narrow, [](int subscriber) { return subscriber == 2; }), 1);
+  CHECK_EQ(*before, std::vector<int>{ 2, 3 });
+  CHECK_EQ(*index.find(narrow), std::vector<int>{ 3 });
+  CHECK_EQ(subscribers(index, name), std::vector<int>{ 1, 3 });
+
+  CHECK_EQ(index.erase_if(narrow, [](int) { return true; }), 1);
+  CHECK_FALSE(index.find(narrow));
+  CHECK_EQ(index.erase_if(narrow, [](int) { return true; }), 0);
+  CHECK_EQ(subscribers(index, name), std::vector<int>{ 1 });
+}
+
+TEST_CASE("quicr::FanoutIndex Nested Read Test")
+{
+  // An index's snapshot outlives the thread reading another index of the
+  // same type, or changing it, while fanning out
+  quicr::FanoutIndex<int> index;
+  quicr::FanoutIndex<int> other;
+  const quicr::Name name = 0x11111111111111112222222222222233_name;
+  const quicr::Namespace ns{ name, 120 };
+
+  index.add(ns, 1);
+  index.add(ns, 2);
+  other.add(ns, 3);
+
+  std::vector<int> found;
+  index.for_each(name, [&](int subscriber) {
+    found.push_back(subscriber);
+    index.erase_if(ns, [](int) { return true; });
+    CHECK_EQ(subscribers(other, name), std::vector<int>{ 3 });
+  });
+
+  CHECK_EQ(found, std::vector<int>{ 1, 2 });
+  CHECK(subscribers(index, name).empty());
+}
+
+TEST_CASE("quicr::FanoutIndex Concurrent Read Test")
+{
+  // Readers see whole snapshots while subscribers change
+  quicr::FanoutIndex<int> index;
+  const quicr::Namespace ns{ 0x11111111111111112222222222222200_name, 120 };
+  std::atomic<bool> done{ false };
+  std::atomic<size_t> torn{ 0 };
+
+  std::vector<std::thread> readers;
+  for (int i = 0; i < 4; ++i) {
+    readers.emplace_back([&] {
+      while (!done) {
+        // Subscribers are added in order, and removed from the front
+        int previous = -1;
+        index.for_each(ns.name(), [&](int subscriber) {
+          if (previous != -1 && subscriber != previous + 1)
+            ++torn;
+          previous = subscriber;
+        });
+      }
+    });
+  }
+
+  for (int i = 0; i < 2000; ++i) {
+    index.add(ns, i);
+    if (i % 2)
+      index.erase_if(ns, [i](int subscriber) { return subscriber == i / 2; });
+  }
+
+  done = true;
+  for (auto& reader : readers)
+    reader.join();
+
+  CHECK_EQ(torn, 0);
+  CHECK_EQ(index.find(ns)->size(), 1000);
+}
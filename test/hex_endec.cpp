@@ -106,3 +106,50 @@ TEST_CASE("quicr::HexEndec Decode quicr::Name")
     std::array<uint64_t, 3>{ 0x1111111111111111, 0x22222222222222, 0x33 });
   CHECK_EQ(results[0], 0x1111111111111111);
 }
+
+TEST_CASE("quicr::HexEndec Encode/Decode quicr::Name directly")
+{
+  using Format = quicr::HexEndec<128, 24, 8, 24, 8, 16, 48>;
+  const uint32_t org_id = 0x00A11CEE;
+  const uint8_t app_id = 0x01;
+  const uint32_t conf_id = 0x00F00001;
+  const uint8_t media_type = 0x02;
+  const uint16_t client_id = 0xFFFF;
+  const uint64_t unique_id = 0x123456789ABC;
+
+  constexpr quicr::Name name = Format::EncodeName(
+    org_id, app_id, conf_id, media_type, client_id, unique_id);
+  CHECK_EQ(name, 0xA11CEE01F0000102FFFF123456789ABC_name);
+  CHECK_EQ(name,
+           quicr::Name(Format::Encode(
+             org_id, app_id, conf_id, media_type, client_id, unique_id)));
+
+  // Bits beyond each value's distribution are dropped
+  CHECK_EQ(Format::EncodeName(0xFFA11CEEu,
+                              app_id,
+                              conf_id,
+                              media_type,
+                              client_id,
+                              0xFFFF123456789ABCull),
+           name);
+
+  constexpr auto values = Format::DecodeName(name);
+  CHECK_EQ(values,
+           std::array<uint64_t, 6>{
+             org_id, app_id, conf_id, media_type, client_id, unique_id });
+  CHECK_EQ(values, Format::Decode(std::string_view(name.to_hex())));
+
+  // Values straddling the two 64 bit words
+  using Straddle = quicr::HexEndec<128, 60, 8, 60>;
+  const auto straddle = Straddle::EncodeName(0x0ull, 0xABu, 0x0ull);
+  CHECK_EQ(straddle, quicr::Name(0xA, 0xB000000000000000));
+  CHECK_EQ(Straddle::DecodeName(straddle),
+           std::array<uint64_t, 3>{ 0x0, 0xAB, 0x0 });
+
+  // Smaller formats are held in the low bits of the name
+  using Small = quicr::HexEndec<64, 32, 24, 8>;
+  const auto small = Small::EncodeName(0x11111111u, 0x222222u, 0x33u);
+  CHECK_EQ(small, quicr::Name(Small::Encode(0x11111111u, 0x222222u, 0x33u)));
+  CHECK_EQ(Small::DecodeName(small),
+           std::array<uint64_t, 3>{ 0x11111111, 0x222222, 0x33 });
+}
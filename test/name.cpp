@@ -1,8 +1,10 @@
 #include <doctest/doctest.h>
 
+#include <quicr/hex.h>
 #include <quicr/quicr_name.h>
 
 #include <type_traits>
+#include <unordered_set>
 
 TEST_CASE("quicr::Name Constructor Tests")
 {
@@ -55,6 +57,31 @@ TEST_CASE("quicr::Name To Hex Tests")
     CHECK_EQ(long_name.to_hex(), not_short_name.to_hex());
     CHECK_EQ(long_name, not_short_name);
   }
+  {
+    std::string_view mixed_hex = "0x0123456789abcdefFEDCBA9876543210";
+    quicr::Name name = mixed_hex;
+    CHECK_EQ(name, quicr::Name(0x0123456789ABCDEF, 0xFEDCBA9876543210));
+
+    char buffer[quicr::Name::hex_size];
+    CHECK_EQ(name.to_hex(buffer), "0x0123456789ABCDEFFEDCBA9876543210");
+    CHECK_EQ(name.to_hex(), "0x0123456789ABCDEFFEDCBA9876543210");
+  }
+  {
+    uint64_t hi, low;
+    CHECK(quicr::hex::decode("A11CEE00F00001000000000000000001", hi, low));
+    CHECK_EQ(hi, 0xA11CEE00F0000100);
+    CHECK_EQ(low, 0x1);
+    CHECK_FALSE(
+      quicr::hex::decode("A11CEE00F0000100000000000000000G", hi, low));
+    CHECK_FALSE(
+      quicr::hex::decode("A11CEE00F000010000000000:0000001", hi, low));
+    CHECK_FALSE(
+      quicr::hex::decode("A11CEE00F00001000000000000000\x10" "00", hi, low));
+
+    char buffer[16];
+    quicr::hex::encode(0xA11CEE00F0000100, buffer);
+    CHECK_EQ(std::string_view(buffer, sizeof(buffer)), "A11CEE00F0000100");
+  }
 }
 
 TEST_CASE("quicr::Name Bit Shifting Tests")
@@ -102,6 +129,41 @@ TEST_CASE("quicr::Name Bit Shifting Tests")
   }
 }
 
+TEST_CASE("quicr::Name Constexpr Tests")
+{
+  static_assert((0x1234_name >> 4) == 0x123_name);
+  static_assert((0x1234_name << 68) == quicr::Name(0x12340, 0));
+  static_assert((0x1234_name << 128) == 0x0_name);
+  static_assert((~0x0_name >> 128) == 0x0_name);
+  static_assert(0x0000000000000000FFFFFFFFFFFFFFFF_name + 1 ==
+                0x00000000000000010000000000000000_name);
+  static_assert((0xFF00_name & 0x0FF0_name) == 0x0F00_name);
+  static_assert((0xFF00_name | 0x00FF) == 0xFFFF_name);
+  static_assert(0x20000000000000001_name > 0x10000000000000002_name);
+  static_assert(0x123_name[1] == 0x01);
+  CHECK(true);
+}
+
+TEST_CASE("quicr::Name Ordering and Hash Tests")
+{
+  static_assert((0x1_name <=> 0x2_name) < 0);
+  static_assert((0x10000000000000000_name <=> 0xFFFFFFFFFFFFFFFF_name) > 0);
+  static_assert((0x42_name <=> 0x42_name) == 0);
+  CHECK_LE(0x42_name, 0x42_name);
+  CHECK_GE(0x20000000000000001_name, 0x10000000000000002_name);
+
+  std::unordered_set<quicr::Name> names;
+  for (uint64_t i = 0; i < 1000; ++i) {
+    names.insert(quicr::Name(i, 0));
+    names.insert(quicr::Name(uint64_t{ 0 }, i));
+  }
+  CHECK_EQ(names.size(), 1999);
+  CHECK(names.contains(quicr::Name(999, 0)));
+  CHECK_FALSE(names.contains(quicr::Name(1000, 0)));
+  CHECK_EQ(std::hash<quicr::Name>{}(0x42_name),
+           std::hash<quicr::Name>{}(0x41_name + 1));
+}
+
 TEST_CASE("quicr::Name Arithmetic Tests")
 {
   quicr::Name val42 = 0x42_name;
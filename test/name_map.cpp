@@ -0,0 +1,71 @@
+#include <doctest/doctest.h>
+
+#include <quicr/name_map.h>
+
+#include <random>
+#include <unordered_map>
+
+TEST_CASE("quicr::NameMap Insert/Find/Erase Test")
+{
+  quicr::NameMap<int> map;
+  CHECK(map.empty());
+  CHECK_FALSE(map.find(0x0_name));
+  CHECK_FALSE(map.erase(0x0_name));
+
+  const quicr::Name name = 0x11111111111111112222222222222233_name;
+  auto [value, inserted] = map.try_emplace(name, 1);
+  CHECK(inserted);
+  CHECK_EQ(*value, 1);
+
+  std::tie(value, inserted) = map.try_emplace(name, 2);
+  CHECK_FALSE(inserted);
+  CHECK_EQ(*value, 1);
+
+  map[0x0_name] = 3;
+  CHECK_EQ(map.size(), 2);
+  CHECK_EQ(*map.find(0x0_name), 3);
+  CHECK(map.contains(name));
+  CHECK_FALSE(map.contains(name + 1));
+
+  CHECK(map.erase(name));
+  CHECK_FALSE(map.erase(name));
+  CHECK_FALSE(map.find(name));
+  CHECK_EQ(map.size(), 1);
+
+  map.clear();
+  CHECK(map.empty());
+  CHECK_FALSE(map.find(0x0_name));
+}
+
+TEST_CASE("quicr::NameMap Matches std::unordered_map Test")
+{
+  // Few distinct names, so probe runs collide and erases shift them back
+  std::mt19937_64 rng(1);
+  quicr::NameMap<uint64_t> map;
+  std::unordered_map<quicr::Name, uint64_t> expected;
+
+  for (uint64_t i = 0; i < 20000; ++i) {
+    const quicr::Name name(0xA11CEE00F0000100, rng() % 512);
+    if (rng() % 3 == 0) {
+      CHECK_EQ(map.erase(name), expected.erase(name) == 1);
+    } else {
+      map[name] = i;
+      expected[name] = i;
+    }
+
+    const quicr::Name probe(0xA11CEE00F0000100, rng() % 512);
+    const auto* value = map.find(probe);
+    REQUIRE_EQ(value != nullptr, expected.contains(probe));
+    if (value)
+      CHECK_EQ(*value, expected[probe]);
+  }
+
+  CHECK_EQ(map.size(), expected.size());
+
+  size_t visited = 0;
+  map.for_each([&](const quicr::Name& name, uint64_t& value) {
+    CHECK_EQ(value, expected[name]);
+    ++visited;
+  });
+  CHECK_EQ(visited, expected.size());
+}
@@ -3,6 +3,7 @@
 #include <quicr/quicr_namespace.h>
 
 #include <type_traits>
+#include <unordered_map>
 
 TEST_CASE("quicr::Namespace Constructor Tests")
 {
@@ -40,3 +41,34 @@ TEST_CASE("quicr::Namespace Contains Namespaces Test")
   quicr::Namespace invalid_namespace(0x11111111111111112222222222000000_name, 104);
   CHECK_FALSE(base_namespace.contains(invalid_namespace));
 }
+
+TEST_CASE("quicr::Namespace Constexpr Test")
+{
+  constexpr quicr::Namespace ns(0x11111111111111112222222222222233_name, 120);
+  static_assert(ns.name() == 0x11111111111111112222222222222200_name);
+  static_assert(ns.mask() == 0xFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF00_name);
+  static_assert(ns.contains(0x111111111111111122222222222222FF_name));
+  static_assert(!ns.contains(0x11111111111111112222222222222300_name));
+
+  constexpr quicr::Namespace whole(0x11111111111111112222222222222233_name,
+                                   128);
+  CHECK_EQ(whole.name(), 0x11111111111111112222222222222233_name);
+  CHECK(whole.contains(0x11111111111111112222222222222233_name));
+  CHECK_FALSE(whole.contains(0x11111111111111112222222222222232_name));
+
+  constexpr quicr::Namespace any(0x11111111111111112222222222222233_name, 0);
+  CHECK_EQ(any.name(), 0x0_name);
+  CHECK(any.contains(0xFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF_name));
+}
+
+TEST_CASE("quicr::Namespace Hash Test")
+{
+  std::unordered_map<quicr::Namespace, int> namespaces;
+  namespaces[{ 0x11111111111111112222222222222200_name, 120 }] = 1;
+  namespaces[{ 0x11111111111111112222222222222200_name, 112 }] = 2;
+  namespaces[{ 0x111111111111111122222222222222FF_name, 120 }] = 3;
+
+  CHECK_EQ(namespaces.size(), 2);
+  CHECK_EQ(namespaces.at({ 0x11111111111111112222222222222211_name, 120 }), 3);
+  CHECK_EQ(namespaces.at({ 0x11111111111111112222222222222211_name, 112 }), 2);
+}
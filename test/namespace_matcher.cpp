@@ -0,0 +1,82 @@
+#include <doctest/doctest.h>
+
+#include <quicr/namespace_matcher.h>
+#include <quicr/namespace_trie.h>
+
+#include <random>
+#include <vector>
+
+namespace {
+template<typename Index>
+std::vector<quicr::Namespace>
+matches(Index& index, const quicr::Name& name)
+{
+  std::vector<quicr::Namespace> found;
+  index.for_each_match(
+    name, [&](const quicr::Namespace& ns, int&) { found.push_back(ns); });
+  return found;
+}
+}
+
+TEST_CASE("quicr::NamespaceMatcher Insert/Find/Erase Test")
+{
+  quicr::NamespaceMatcher<int> matcher;
+  CHECK(matcher.empty());
+
+  const quicr::Name name = 0x11111111111111112222222222222233_name;
+  matcher[{ name, 0 }] = 0;
+  matcher[{ name, 64 }] = 64;
+  matcher[{ name, 120 }] = 120;
+  matcher[{ name, 128 }] = 128;
+  matcher[{ 0x11111111111111112222222222223333_name, 120 }] = -1;
+  CHECK_EQ(matcher.size(), 5);
+
+  REQUIRE(matcher.find({ name, 120 }));
+  CHECK_EQ(*matcher.find({ name, 120 }), 120);
+  CHECK_FALSE(matcher.find({ name, 112 }));
+
+  CHECK_EQ(matches(matcher, name),
+           std::vector<quicr::Namespace>{
+             { name, 0 }, { name, 64 }, { name, 120 }, { name, 128 } });
+  CHECK_EQ(matches(matcher, 0x21111111111111112222222222222233_name),
+           std::vector<quicr::Namespace>{ { name, 0 } });
+
+  CHECK(matcher.erase({ name, 0 }));
+  CHECK_FALSE(matcher.erase({ name, 0 }));
+  CHECK_FALSE(matcher.matches(0x21111111111111112222222222222233_name));
+  CHECK(matcher.matches(0x111111111111111122222222222233FF_name));
+
+  matcher.clear();
+  CHECK(matcher.empty());
+  CHECK_FALSE(matcher.matches(name));
+}
+
+TEST_CASE("quicr::NamespaceMatcher Matches NamespaceTrie Test")
+{
+  std::mt19937_64 rng(1);
+  quicr::NamespaceMatcher<int> matcher;
+  quicr::NamespaceTrie<int> trie;
+  std::vector<quicr::Namespace> namespaces;
+
+  const quicr::Name base = 0xA11CEE00F00001000000000000000000_name;
+  for (int i = 0; i < 2000; ++i) {
+    const quicr::Name name = base ^ quicr::Name(rng() >> (rng() % 64), rng());
+    const quicr::Namespace ns{ name, static_cast<uint8_t>(rng() % 129) };
+    namespaces.push_back(ns);
+    matcher[ns] = i;
+    trie[ns] = i;
+  }
+
+  for (int i = 0; i < 1000; ++i) {
+    if (i % 2) {
+      CHECK_EQ(matcher.erase(namespaces[i]), trie.erase(namespaces[i]));
+    }
+
+    const quicr::Name name = base ^ quicr::Name(rng() >> (rng() % 64), rng());
+    const auto found = matches(matcher, name);
+    CHECK_EQ(found, matches(trie, name));
+    CHECK_EQ(matcher.matches(name), !found.empty());
+  }
+
+  CHECK_EQ(matcher.size(), trie.size());
+}
@@ -0,0 +1,110 @@
+#include <doctest/doctest.h>
+
+#include <quicr/namespace_trie.h>
+
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+std::vector<quicr::Namespace>
+matches(quicr::NamespaceTrie<int>& trie, const quicr::Name& name)
+{
+  std::vector<quicr::Namespace> found;
+  trie.for_each_match(
+    name, [&](const quicr::Namespace& ns, int&) { found.push_back(ns); });
+  return found;
+}
+}
+
+TEST_CASE("quicr::NamespaceTrie Insert/Find/Erase Test")
+{
+  quicr::NamespaceTrie<int> trie;
+  CHECK(trie.empty());
+
+  const quicr::Namespace wide{ 0x11111111111111112222222222220000_name, 112 };
+  const quicr::Namespace narrow{ 0x11111111111111112222222222222200_name,
+                                 120 };
+  const quicr::Namespace sibling{ 0x11111111111111112222222222223300_name,
+                                  120 };
+
+  trie[narrow] = 1;
+  trie[sibling] = 2;
+  trie[wide] = 3;
+  CHECK_EQ(trie.size(), 3);
+
+  REQUIRE(trie.find(narrow));
+  CHECK_EQ(*trie.find(narrow), 1);
+  CHECK_EQ(*trie.find(sibling), 2);
+  CHECK_EQ(*trie.find(wide), 3);
+  CHECK_FALSE(trie.find({ 0x11111111111111112222222222220000_name, 104 }));
+
+  // Split nodes are not values
+  CHECK_FALSE(trie.find({ 0x11111111111111112222222222222000_name, 114 }));
+
+  CHECK(trie.erase(wide));
+  CHECK_FALSE(trie.erase(wide));
+  CHECK_FALSE(trie.find(wide));
+  CHECK_EQ(*trie.find(narrow), 1);
+  CHECK_EQ(*trie.find(sibling), 2);
+
+  CHECK(trie.erase(narrow));
+  CHECK(trie.erase(sibling));
+  CHECK(trie.empty());
+}
+
+TEST_CASE("quicr::NamespaceTrie Matching Test")
+{
+  quicr::NamespaceTrie<int> trie;
+  const quicr::Name name = 0x11111111111111112222222222222233_name;
+
+  trie[{ name, 0 }] = 0;
+  trie[{ name, 64 }] = 64;
+  trie[{ name, 120 }] = 120;
+  trie[{ name, 128 }] = 128;
+  trie[{ 0x11111111111111112222222222223333_name, 120 }] = -1;
+
+  CHECK_EQ(matches(trie, name),
+           std::vector<quicr::Namespace>{
+             { name, 0 }, { name, 64 }, { name, 120 }, { name, 128 } });
+  CHECK_EQ(matches(trie, 0x111111111111111122222222222222FF_name),
+           std::vector<quicr::Namespace>{
+             { name, 0 }, { name, 64 }, { name, 120 } });
+  CHECK_EQ(matches(trie, 0x21111111111111112222222222222233_name),
+           std::vector<quicr::Namespace>{ { name, 0 } });
+}
+
+TEST_CASE("quicr::NamespaceTrie Matches Prefix Scan Test")
+{
+  // Compare against probing every prefix length of a map per length
+  std::mt19937_64 rng(1);
+  quicr::NamespaceTrie<int> trie;
+  std::unordered_map<quicr::Namespace, int> namespaces;
+
+  const quicr::Name base = 0xA11CEE00F00001000000000000000000_name;
+  for (int i = 0; i < 2000; ++i) {
+    const quicr::Name name = base ^ quicr::Name(rng() >> (rng() % 64), rng());
+    const quicr::Namespace ns{ name, static_cast<uint8_t>(rng() % 129) };
+    namespaces[ns] = i;
+    trie[ns] = i;
+  }
+
+  for (int i = 0; i < 1000; ++i) {
+    if (i % 2) {
+      CHECK(trie.erase(namespaces.begin()->first));
+      namespaces.erase(namespaces.begin());
+    }
+
+    const quicr::Name name = base ^ quicr::Name(rng() >> (rng() % 64), rng());
+    std::vector<quicr::Namespace> expected;
+    for (int len = 0; len <= 128; ++len) {
+      const quicr::Namespace ns{ name, static_cast<uint8_t>(len) };
+      if (namespaces.contains(ns))
+        expected.push_back(ns);
+    }
+
+    CHECK_EQ(matches(trie, name), expected);
+  }
+
+  CHECK_EQ(trie.size(), namespaces.size());
+}
@@ -1,5 +1,8 @@
+#include <algorithm>
+#include <chrono>
 #include <memory>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "fake_transport.h"
@@ -100,3 +103,274 @@ TEST_CASE("Publish encode, send and receive")
   say_hello = { 'H', 'E', 'L', 'L', '0' };
   CHECK_EQ(d.media_data, say_hello);
 }
+
+TEST_CASE("Publish coalesces small objects until flush")
+{
+  auto transport = std::make_shared<FakeTransport>();
+  auto qclient = std::make_unique<QuicRClient>(transport);
+  qclient->setCoalescing(true);
+
+  for (uint8_t i = 0; i < 3; ++i) {
+    qclient->publishNamedObject(
+      0x10000000000000002000_name, 0, 0, false, bytes(40, i));
+  }
+  CHECK(transport->stored_data.empty());
+
+  qclient->flush();
+  REQUIRE_FALSE(transport->stored_data.empty());
+
+  std::vector<bytes> payloads;
+  auto status = messages::for_each_batched(
+    transport->stored_data, [&](messages::MessageBufferView&& msg) {
+      messages::PublishDatagramView d;
+      REQUIRE_EQ(messages::try_decode(msg, d), messages::DecodeStatus::Ok);
+      payloads.emplace_back(d.media_data.begin(), d.media_data.end());
+    });
+
+  CHECK_EQ(status, messages::DecodeStatus::Ok);
+  REQUIRE_EQ(payloads.size(), 3);
+  for (uint8_t i = 0; i < 3; ++i) {
+    CHECK_EQ(payloads[i], bytes(40, i));
+  }
+}
+
+TEST_CASE("Batches the transport has no room for are kept for the next flush")
+{
+  auto transport = std::make_shared<FakeTransport>();
+  auto qclient = std::make_unique<QuicRClient>(transport);
+  qclient->setCoalescing(true);
+
+  for (uint8_t i = 0; i < 3; ++i) {
+    qclient->publishNamedObject(
+      0x10000000000000002000_name, 0, 0, false, bytes(40, i));
+  }
+
+  transport->queue_full = true;
+  CHECK_EQ(qclient->flush(), TransportError::QueueFull);
+  CHECK(transport->sent.empty());
+
+  transport->queue_full = false;
+  CHECK_EQ(qclient->flush(), TransportError::None);
+  REQUIRE_EQ(transport->sent.size(), 1);
+
+  size_t count = 0;
+  auto status = messages::for_each_batched(
+    transport->sent.front(), [&](messages::MessageBufferView&&) { ++count; });
+  CHECK_EQ(status, messages::DecodeStatus::Ok);
+  CHECK_EQ(count, 3);
+}
+
+TEST_CASE("Objects read from a stream in chunks are reassembled")
+{
+  struct ObjectDelegate : public TestSubscriberDelegate
+  {
+    void onSubscribedObject(const quicr::Name& /* quicr_name */,
+                            uint8_t /* priority */,
+                            uint16_t /* expiry_age_ms */,
+                            bool /* use_reliable_transport */,
+                            bytes&& data)
+    {
+      objects.push_back(std::move(data));
+    }
+
+    std::vector<bytes> objects;
+  };
+
+  auto transport = std::make_shared<FakeTransport>();
+  auto qclient = std::make_unique<QuicRClient>(transport);
+  auto sub_delegate = std::make_shared<ObjectDelegate>();
+  qclient->subscribe(sub_delegate,
+                     { 0x10000000000000002000_name, 80 },
+                     SubscribeIntent::immediate,
+                     "",
+                     false,
+                     "",
+                     {});
+
+  bytes object(50000);
+  for (size_t i = 0; i < object.size(); ++i)
+    object[i] = static_cast<uint8_t>(i);
+
+  messages::PublishDatagram datagram;
+  datagram.header.name = 0x10000000000000002000_name;
+  datagram.header.offset_and_fin = uintVar_t{ 1 };
+  datagram.media_type = messages::MediaType::RealtimeMedia;
+  datagram.media_data_length = uintVar_t{ object.size() };
+  datagram.media_data = object;
+
+  messages::MessageBuffer msg;
+  msg << datagram;
+  const auto stream = msg.get();
+
+  // A reliable stream the server opened
+  qclient->handle_new_stream(0x3000);
+  for (size_t offset = 0; offset < stream.size(); offset += 3000) {
+    qclient->handle(0x3000,
+                    std::span(stream).subspan(
+                      offset, std::min<size_t>(3000, stream.size() - offset)));
+  }
+
+  REQUIRE_EQ(sub_delegate->objects.size(), 1);
+  CHECK_EQ(sub_delegate->objects.front(), object);
+}
+
+TEST_CASE("Truncated datagrams are dropped without affecting the next")
+{
+  struct ObjectDelegate : public TestSubscriberDelegate
+  {
+    void onSubscribedObject(const quicr::Name& /* quicr_name */,
+                            uint8_t /* priority */,
+                            uint16_t /* expiry_age_ms */,
+                            bool /* use_reliable_transport */,
+                            bytes&& data)
+    {
+      objects.push_back(std::move(data));
+    }
+
+    std::vector<bytes> objects;
+  };
+
+  auto transport = std::make_shared<FakeTransport>();
+  auto qclient = std::make_unique<QuicRClient>(transport);
+  auto sub_delegate = std::make_shared<ObjectDelegate>();
+  qclient->subscribe(sub_delegate,
+                     { 0x10000000000000002000_name, 80 },
+                     SubscribeIntent::immediate,
+                     "",
+                     false,
+                     "",
+                     {});
+
+  messages::PublishDatagram datagram;
+  datagram.header.name = 0x10000000000000002000_name;
+  datagram.header.offset_and_fin = uintVar_t{ 1 };
+  datagram.media_type = messages::MediaType::RealtimeMedia;
+  datagram.media_data_length = uintVar_t{ 100 };
+  datagram.media_data = bytes(100, 0xAB);
+
+  messages::MessageBuffer msg;
+  msg << datagram;
+  auto truncated = msg.get();
+  truncated.resize(truncated.size() - 10);
+
+  const bytes object{ 1, 2, 3, 4 };
+  datagram.media_data_length = uintVar_t{ object.size() };
+  datagram.media_data = object;
+  msg << datagram;
+  const auto whole = msg.get();
+
+  // Both arrive on the client's own datagram stream
+  qclient->handle(0x2000, truncated);
+  qclient->handle(0x2000, whole);
+
+  REQUIRE_EQ(sub_delegate->objects.size(), 1);
+  CHECK_EQ(sub_delegate->objects.front(), object);
+}
+
+TEST_CASE("Publish sends higher priorities first and drops expired objects")
+{
+  auto transport = std::make_shared<FakeTransport>();
+  auto qclient = std::make_unique<QuicRClient>(transport);
+
+  const auto video_keyframe = 0x10000000000000001000_name;
+  const auto video_delta = 0x10000000000000001001_name;
+  const auto audio = 0x10000000000000002000_name;
+
+  // Congested: nothing reaches the wire, video queues ahead of the audio
+  transport->queue_full = true;
+  qclient->publishNamedObject(video_keyframe, 2, 1, false, bytes(900, 0x1));
+  qclient->publishNamedObject(video_delta, 2, 0, false, bytes(300, 0x2));
+  qclient->publishNamedObject(audio, 0, 0, false, bytes(80, 0x3));
+  qclient->publishNamedObject(audio + 1, 0, 0, false, bytes(80, 0x4));
+  CHECK(transport->sent.empty());
+
+  // The keyframe is stale by the time the transport takes data again
+  std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  transport->queue_full = false;
+  qclient->flush();
+
+  std::vector<quicr::Name> names;
+  for (auto& packet : transport->sent) {
+    messages::PublishDatagram d;
+    messages::MessageBuffer msg{ std::move(packet) };
+    msg >> d;
+    names.push_back(d.header.name);
+  }
+
+  CHECK_EQ(names, std::vector<quicr::Name>{ audio, audio + 1, video_delta });
+}
+
+TEST_CASE("Publish sends each priority and reliability on its own stream")
+{
+  auto transport = std::make_shared<FakeTransport>();
+  auto qclient = std::make_unique<QuicRClient>(transport);
+
+  const auto name = 0x10000000000000002000_name;
+  qclient->publishNamedObject(name, 0, 0, false, bytes(80, 0x1));
+  qclient->publishNamedObject(name + 1, 2, 0, false, bytes(900, 0x2));
+  qclient->publishNamedObject(name + 2, 0, 0, false, bytes(80, 0x3));
+  qclient->publishNamedObject(name + 3, 2, 0, true, bytes(900, 0x4));
+
+  REQUIRE_EQ(transport->reliable_streams,
+             std::vector<bool>{ false, false, true });
+  REQUIRE_EQ(transport->sent.size(), 4);
+
+  const auto& streams = transport->sent_streams;
+  CHECK_EQ(streams[0], streams[2]);
+  CHECK_NE(streams[0], streams[1]);
+  CHECK_NE(streams[1], streams[3]);
+  CHECK_EQ(transport->reliable_streams[streams[3] - 0x2000], true);
+
+  // The media id is the connection's, whichever stream carries the object
+  std::vector<uint64_t> media_ids;
+  for (size_t i = 0; i < transport->sent.size(); ++i) {
+    messages::PublishDatagram d;
+    messages::MessageBuffer msg{ std::move(transport->sent[i]) };
+    msg >> d;
+    CHECK_EQ(d.header.name, name + i);
+    media_ids.push_back(d.header.media_id);
+  }
+
+  CHECK(std::all_of(media_ids.begin(), media_ids.end(), [&](auto media_id) {
+    return media_id == media_ids.front();
+  }));
+}
+
+TEST_CASE("Objects held back by a full queue are retried without a flush")
+{
+  auto transport = std::make_shared<FakeTransport>();
+  auto qclient = std::make_unique<QuicRClient>(transport);
+
+  transport->queue_full = true;
+  qclient->publishNamedObject(
+    0x10000000000000002000_name, 0, 0, false, bytes(80, 0x1));
+
+  // Fragments of a large object are queued whole, with no wait on publish
+  qclient->publishNamedObject(0x10000000000000002001_name,
+                              0,
+                              0,
+                              false,
+                              bytes(3 * quicr::MAX_TRANSPORT_DATA_SIZE, 0x2));
+  transport->queue_full = false;
+
+  // The retry thread sends them once the transport has room, however it is
+  // scheduled, so wait on it for at most a second
+  for (int i = 0; i < 1000 && transport->sent_count < 4; ++i)
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  REQUIRE_EQ(transport->sent_count, 4);
+
+  qclient.reset();
+  REQUIRE_EQ(transport->sent.size(), 4);
+
+  std::vector<uint64_t> offset_and_fin;
+  for (auto& packet : transport->sent) {
+    messages::PublishDatagram d;
+    messages::MessageBuffer msg{ std::move(packet) };
+    msg >> d;
+    offset_and_fin.push_back(uint64_t(d.header.offset_and_fin));
+  }
+
+  const uint64_t size = quicr::MAX_TRANSPORT_DATA_SIZE;
+  CHECK_EQ(offset_and_fin,
+           std::vector<uint64_t>{ 1, 0, size << 1, ((2 * size) << 1) + 1 });
+}
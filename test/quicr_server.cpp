@@ -115,3 +115,106 @@ TEST_CASE("Send Object Message Encode, send and receive")
   CHECK_EQ(d.media_data, say_hello);
 }
 #endif
+
+TEST_CASE("Objects are sent on a stream per connection and priority")
+{
+  TestServerDelegate delegate{};
+  qtransport::LogHandler logger;
+  auto transport = std::make_shared<FakeTransport>();
+  auto qserver = std::make_unique<QuicRServer>(transport, delegate, logger);
+
+  std::vector<uint8_t> data(100, 0x1);
+  messages::PublishDatagram datagram;
+  datagram.header.name = 0x10000000000000002000_name;
+  datagram.header.media_id = uintVar_t{ 0 };
+  datagram.header.group_id = uintVar_t{ 0 };
+  datagram.header.object_id = uintVar_t{ 0 };
+  datagram.header.offset_and_fin = uintVar_t{ 1 };
+  datagram.header.flags = 0;
+  datagram.media_type = messages::MediaType::RealtimeMedia;
+  datagram.media_data_length = uintVar_t{ data.size() };
+  datagram.media_data = data;
+
+  for (const uint8_t priority : { 0, 3, 0 }) {
+    qserver->sendNamedObject(0x1000, 0x10, priority, false, datagram);
+  }
+
+  qserver->sendNamedObject(0x1001, 0x10, 3, false, datagram);
+  qserver->sendEncodedObject(
+    0x1000, 0x10, 3, true, qserver->encodeNamedObject(datagram).view().data());
+
+  // Priorities from max_priority on share a stream
+  qserver->sendNamedObject(
+    0x1000, 0x10, StreamMap::max_priority, false, datagram);
+  qserver->sendNamedObject(0x1000, 0x10, 200, false, datagram);
+
+  CHECK_EQ(transport->reliable_streams,
+           std::vector<bool>{ false, false, false, true, false });
+
+  const auto& streams = transport->sent_streams;
+  REQUIRE_EQ(streams.size(), 7);
+  CHECK_EQ(streams[0], streams[2]);
+  CHECK_NE(streams[0], streams[1]);
+  CHECK_NE(streams[1], streams[3]);
+  CHECK_NE(streams[1], streams[4]);
+  CHECK_NE(streams[5], streams[1]);
+  CHECK_EQ(streams[5], streams[6]);
+
+  messages::PublishDatagram d;
+  messages::MessageBuffer msg{ std::move(transport->sent[3]) };
+  msg >> d;
+  CHECK_EQ(d.header.name, datagram.header.name);
+  CHECK_EQ(d.media_data, data);
+}
+
+TEST_CASE("Forwarded objects are sent on a stream per source stream")
+{
+  TestServerDelegate delegate{};
+  qtransport::LogHandler logger;
+  auto transport = std::make_shared<FakeTransport>();
+  auto qserver = std::make_unique<QuicRServer>(transport, delegate, logger);
+
+  const std::vector<uint8_t> encoded(100, 0x1);
+
+  // Two streams of one publisher, and one of another
+  qserver->forwardEncodedObject(0x1000, 0x1001, 0x10, false, encoded);
+  qserver->forwardEncodedObject(0x1000, 0x1001, 0x11, false, encoded);
+  qserver->forwardEncodedObject(0x1000, 0x1002, 0x10, false, encoded);
+  qserver->forwardEncodedObject(0x1000, 0x1001, 0x10, false, encoded);
+
+  const auto& streams = transport->sent_streams;
+  REQUIRE_EQ(streams.size(), 4);
+  CHECK_NE(streams[0], streams[1]);
+  CHECK_NE(streams[0], streams[2]);
+  CHECK_NE(streams[1], streams[2]);
+  CHECK_EQ(streams[0], streams[3]);
+  CHECK_EQ(transport->sent[3], encoded);
+}
+
+TEST_CASE("Forwarded streams are returned when their source is forgotten")
+{
+  FakeTransport transport;
+  StreamMap streams;
+
+  const auto forwarded = streams.get(transport, 0x1000, 0x1001, 0x10, false);
+  streams.get(transport, 0x1000, 0x1002, 0x10, false);
+  streams.get(transport, 0x1001, 0, false);
+  REQUIRE_EQ(streams.size(), 3);
+
+  using Streams = std::vector<std::pair<TransportContextId, StreamId>>;
+  CHECK_EQ(streams.erase(0x1001), Streams{ { 0x1000, forwarded } });
+  CHECK_EQ(streams.size(), 1);
+  CHECK(streams.erase(0x1000).empty());
+  CHECK_EQ(streams.size(), 0);
+}
+
+TEST_CASE("Receive workers are set once")
+{
+  TestServerDelegate delegate{};
+  qtransport::LogHandler logger;
+  auto transport = std::make_shared<FakeTransport>();
+  QuicRServer server{ transport, delegate, logger };
+
+  CHECK_NOTHROW(server.setReceiveWorkers(2));
+  CHECK_THROWS_AS(server.setReceiveWorkers(4), std::runtime_error);
+}
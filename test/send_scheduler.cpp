@@ -0,0 +1,184 @@
+#include <doctest/doctest.h>
+
+#include <quicr/send_scheduler.h>
+
+#include <chrono>
+#include <vector>
+
+using quicr::SendScheduler;
+using qtransport::StreamId;
+using qtransport::TransportError;
+
+namespace {
+struct Sent
+{
+  StreamId stream_id;
+  std::vector<uint8_t> packet;
+};
+}
+
+TEST_CASE("quicr::SendScheduler Priority Order Test")
+{
+  SendScheduler scheduler;
+  const auto now = SendScheduler::Clock::now();
+
+  scheduler.push(3, 0, 0x1, { 30 }, false, now);
+  scheduler.push(0, 0, 0x2, { 0 }, false, now);
+  scheduler.push(3, 0, 0x1, { 31 }, true, now);
+  scheduler.push(1, 0, 0x2, { 10 }, false, now);
+  CHECK_EQ(scheduler.size(), 4);
+
+  std::vector<uint8_t> order;
+  std::vector<bool> flushes;
+  auto error = scheduler.drain(
+    [&](const StreamId&, std::vector<uint8_t>& packet, bool flush_now) {
+      order.push_back(packet.front());
+      flushes.push_back(flush_now);
+      return SendScheduler::Result{ true, TransportError::None };
+    },
+    now);
+
+  CHECK_EQ(error, TransportError::None);
+  CHECK_EQ(order, std::vector<uint8_t>{ 0, 10, 30, 31 });
+  CHECK_EQ(flushes, std::vector<bool>{ false, false, false, true });
+  CHECK(scheduler.empty());
+}
+
+TEST_CASE("quicr::SendScheduler Expiry Test")
+{
+  SendScheduler scheduler;
+  const auto now = SendScheduler::Clock::now();
+
+  scheduler.push(0, 10, 0x1, { 1 }, false, now);
+  scheduler.push(0, 0, 0x1, { 2 }, false, now);
+  scheduler.push(1, 50, 0x1, { 3 }, false, now);
+
+  std::vector<uint8_t> order;
+  scheduler.drain(
+    [&](const StreamId&, std::vector<uint8_t>& packet, bool) {
+      order.push_back(packet.front());
+      return SendScheduler::Result{ true, TransportError::None };
+    },
+    now + std::chrono::milliseconds(20));
+
+  CHECK_EQ(order, std::vector<uint8_t>{ 2, 3 });
+  CHECK_EQ(scheduler.expired(), 1);
+  CHECK(scheduler.empty());
+}
+
+TEST_CASE("quicr::SendScheduler Queue Full Test")
+{
+  SendScheduler scheduler;
+  const auto now = SendScheduler::Clock::now();
+
+  scheduler.push(1, 0, 0x1, { 1 }, false, now);
+  scheduler.push(1, 0, 0x1, { 2 }, false, now);
+
+  // Declined packets stay queued, in order, behind higher priorities
+  std::vector<Sent> sent;
+  auto error = scheduler.drain(
+    [&](const StreamId&, std::vector<uint8_t>&, bool) {
+      return SendScheduler::Result{ false, TransportError::QueueFull };
+    },
+    now);
+  CHECK_EQ(error, TransportError::QueueFull);
+  CHECK_EQ(scheduler.size(), 2);
+
+  scheduler.push(0, 0, 0x2, { 0 }, false, now);
+  error = scheduler.drain(
+    [&](const StreamId& stream_id, std::vector<uint8_t>& packet, bool) {
+      sent.push_back({ stream_id, std::move(packet) });
+      return SendScheduler::Result{ true, TransportError::None };
+    },
+    now);
+
+  CHECK_EQ(error, TransportError::None);
+  REQUIRE_EQ(sent.size(), 3);
+  CHECK_EQ(sent[0].stream_id, 0x2);
+  CHECK_EQ(sent[0].packet, std::vector<uint8_t>{ 0 });
+  CHECK_EQ(sent[1].packet, std::vector<uint8_t>{ 1 });
+  CHECK_EQ(sent[2].packet, std::vector<uint8_t>{ 2 });
+  CHECK(scheduler.empty());
+}
+
+TEST_CASE("quicr::SendScheduler Full Stream Test")
+{
+  SendScheduler scheduler;
+  const auto now = SendScheduler::Clock::now();
+
+  scheduler.push(0, 0, 0x1, { 1 }, false, now);
+  scheduler.push(0, 0, 0x2, { 2 }, false, now);
+  scheduler.push(0, 0, 0x1, { 3 }, false, now);
+  scheduler.push(1, 0, 0x2, { 4 }, false, now);
+
+  // A full stream holds back only its own packets
+  std::vector<Sent> sent;
+  auto error = scheduler.drain(
+    [&](const StreamId& stream_id, std::vector<uint8_t>& packet, bool) {
+      if (stream_id == 0x1)
+        return SendScheduler::Result{ false, TransportError::QueueFull };
+
+      sent.push_back({ stream_id, std::move(packet) });
+      return SendScheduler::Result{ true, TransportError::None };
+    },
+    now);
+
+  CHECK_EQ(error, TransportError::QueueFull);
+  REQUIRE_EQ(sent.size(), 2);
+  CHECK_EQ(sent[0].packet, std::vector<uint8_t>{ 2 });
+  CHECK_EQ(sent[1].packet, std::vector<uint8_t>{ 4 });
+  CHECK_EQ(scheduler.size(), 2);
+
+  // Taken with the stream's queue full, as when joining a batch that could
+  // not be flushed, ends the stream's drain too
+  std::vector<uint8_t> order;
+  error = scheduler.drain(
+    [&](const StreamId&, std::vector<uint8_t>& packet, bool) {
+      order.push_back(packet.front());
+      return SendScheduler::Result{ true, TransportError::QueueFull };
+    },
+    now);
+
+  CHECK_EQ(error, TransportError::QueueFull);
+  CHECK_EQ(order, std::vector<uint8_t>{ 1 });
+  CHECK_EQ(scheduler.size(), 1);
+}
+
+TEST_CASE("quicr::SendScheduler Fragment Expiry Test")
+{
+  SendScheduler scheduler;
+  const auto now = SendScheduler::Clock::now();
+  const auto later = now + std::chrono::milliseconds(20);
+
+  scheduler.push_fragments(0, 10, 0x1, { { 1 }, { 2 }, { 3 } }, true, now);
+  scheduler.push_fragments(0, 10, 0x1, { { 4 }, { 5 } }, true, now);
+  scheduler.push(0, 0, 0x1, { 6 }, false, now);
+  CHECK_EQ(scheduler.size(), 6);
+
+  // The first object is cut off after its first fragment
+  std::vector<uint8_t> order;
+  scheduler.drain(
+    [&](const StreamId&, std::vector<uint8_t>& packet, bool flush_now) {
+      CHECK(flush_now);
+      if (!order.empty())
+        return SendScheduler::Result{ false, TransportError::QueueFull };
+
+      order.push_back(packet.front());
+      return SendScheduler::Result{ true, TransportError::None };
+    },
+    now);
+  CHECK_EQ(order, std::vector<uint8_t>{ 1 });
+
+  // Once expired, a started object is still sent whole, an unsent one not
+  // at all
+  scheduler.drain(
+    [&](const StreamId&, std::vector<uint8_t>& packet, bool) {
+      order.push_back(packet.front());
+      return SendScheduler::Result{ true, TransportError::None };
+    },
+    later);
+
+  CHECK_EQ(order, std::vector<uint8_t>{ 1, 2, 3, 6 });
+  CHECK_EQ(scheduler.expired(), 1);
+  CHECK(scheduler.empty());
+}
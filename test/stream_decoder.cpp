@@ -0,0 +1,198 @@
+#include <doctest/doctest.h>
+
+#include <quicr/encode.h>
+#include <quicr/stream_decoder.h>
+
+#include <algorithm>
+#include <vector>
+
+using namespace quicr;
+using namespace quicr::messages;
+
+namespace {
+PublishDatagram
+make_datagram(size_t size)
+{
+  Header header{ uintVar_t{ 1 },        0x10000000000000002000_name,
+                 uintVar_t{ 2 },        uintVar_t{ 3 },
+                 uintVar_t{ 1 },        0x00 };
+
+  std::vector<uint8_t> data(size);
+  for (size_t i = 0; i < size; ++i)
+    data[i] = static_cast<uint8_t>(i);
+
+  return { header, MediaType::RealtimeMedia, uintVar_t{ size }, data };
+}
+}
+
+TEST_CASE("StreamDecoder reassembles messages split across reads")
+{
+  quicr::Namespace qnamespace{ 0x10000000000000002000_name, 80 };
+
+  MessageBuffer buffer;
+  buffer << Subscribe{ 1, 0x1000, qnamespace, SubscribeIntent::immediate };
+  buffer << make_datagram(100);
+  buffer << Unsubscribe{ 1, qnamespace };
+  const auto stream = buffer.get();
+
+  // Worst case, every byte arrives in its own read
+  StreamDecoder decoder;
+  std::vector<MessageType> types;
+  PublishDatagram datagram;
+  for (const auto& byte : stream) {
+    auto status = decoder.push(
+      std::span(&byte, 1),
+      [&](MessageBufferView&& msg) {
+        types.push_back(static_cast<MessageType>(msg.front()));
+        if (types.back() == MessageType::Publish)
+          CHECK_EQ(try_decode(msg, datagram), DecodeStatus::Ok);
+      },
+      [&](PublishDatagramView&& fragment) {
+        types.push_back(MessageType::Publish);
+        datagram.media_data.insert(datagram.media_data.end(),
+                                   fragment.media_data.begin(),
+                                   fragment.media_data.end());
+      });
+    REQUIRE_EQ(status, DecodeStatus::Ok);
+  }
+
+  CHECK(decoder.idle());
+  REQUIRE_GE(types.size(), 3);
+  CHECK_EQ(types.front(), MessageType::Subscribe);
+  CHECK_EQ(types.back(), MessageType::Unsubscribe);
+  CHECK_EQ(datagram.media_data, make_datagram(100).media_data);
+
+  // Whole messages in one read are passed on as they are
+  types.clear();
+  CHECK_EQ(decoder.push(
+             stream,
+             [&](MessageBufferView&& msg) {
+               types.push_back(static_cast<MessageType>(msg.front()));
+             },
+             [](PublishDatagramView&&) { FAIL("Unexpected fragment"); }),
+           DecodeStatus::Ok);
+  CHECK_EQ(types,
+           std::vector<MessageType>{ MessageType::Subscribe,
+                                     MessageType::Publish,
+                                     MessageType::Unsubscribe });
+}
+
+TEST_CASE("StreamDecoder frames batches split across reads")
+{
+  quicr::Namespace qnamespace{ 0x10000000000000002000_name, 80 };
+
+  MessageBuffer subscribe;
+  subscribe << Subscribe{ 1, 0x1000, qnamespace, SubscribeIntent::immediate };
+  MessageBuffer unsubscribe;
+  unsubscribe << Unsubscribe{ 1, qnamespace };
+
+  MessageBatch batch;
+  batch.append(subscribe.view().data());
+  batch.append(unsubscribe.view().data());
+
+  // A batch followed by another message, read a few bytes at a time
+  MessageBuffer buffer;
+  buffer.push(batch.flush());
+  buffer.push(subscribe.view().data());
+  const auto stream = buffer.get();
+
+  StreamDecoder decoder;
+  std::vector<MessageType> types;
+  size_t batched = 0;
+  for (size_t offset = 0; offset < stream.size(); offset += 7) {
+    const auto chunk = std::span(stream).subspan(
+      offset, std::min<size_t>(7, stream.size() - offset));
+    auto status = decoder.push(
+      chunk,
+      [&](MessageBufferView&& msg) {
+        types.push_back(static_cast<MessageType>(msg.front()));
+        if (types.back() == MessageType::Batch) {
+          CHECK_EQ(for_each_batched(msg.data(),
+                                    [&](MessageBufferView&&) { ++batched; }),
+                   DecodeStatus::Ok);
+        }
+      },
+      [](PublishDatagramView&&) { FAIL("Unexpected fragment"); });
+    REQUIRE_EQ(status, DecodeStatus::Ok);
+  }
+
+  CHECK(decoder.idle());
+  CHECK_EQ(types,
+           std::vector<MessageType>{ MessageType::Batch,
+                                     MessageType::Subscribe });
+  CHECK_EQ(batched, 2);
+}
+
+TEST_CASE("StreamDecoder yields large objects as fragments")
+{
+  const auto object = make_datagram(100000);
+  MessageBuffer buffer;
+  buffer << object;
+  const auto stream = buffer.get();
+
+  StreamDecoder decoder{ 1000 };
+  std::vector<uint8_t> received;
+  bool fin = false;
+
+  for (size_t offset = 0; offset < stream.size(); offset += 4096) {
+    const auto chunk = std::span(stream).subspan(
+      offset, std::min<size_t>(4096, stream.size() - offset));
+
+    auto status = decoder.push(
+      chunk,
+      [](MessageBufferView&&) { FAIL("Object should not be buffered whole"); },
+      [&](PublishDatagramView&& fragment) {
+        CHECK_FALSE(fin);
+        CHECK_LE(fragment.media_data.size(), 1000);
+        CHECK_EQ(static_cast<size_t>(fragment.media_data_length),
+                 fragment.media_data.size());
+        CHECK_EQ(fragment.header.name, object.header.name);
+        CHECK_EQ(fragment.header.offset_and_fin >> 1, received.size());
+
+        fin = fragment.header.offset_and_fin & 0x1;
+        received.insert(received.end(),
+                        fragment.media_data.begin(),
+                        fragment.media_data.end());
+      });
+    REQUIRE_EQ(status, DecodeStatus::Ok);
+  }
+
+  CHECK(fin);
+  CHECK(decoder.idle());
+  CHECK_EQ(received, object.media_data);
+}
+
+TEST_CASE("StreamDecoder resets on malformed data")
+{
+  StreamDecoder decoder;
+  auto ignore = [](auto&&) {};
+
+  const std::vector<uint8_t> partial{
+    static_cast<uint8_t>(MessageType::Subscribe), 0x00, 0x01
+  };
+  CHECK_EQ(decoder.push(partial, ignore, ignore), DecodeStatus::Ok);
+  CHECK_FALSE(decoder.idle());
+  decoder.reset();
+  CHECK(decoder.idle());
+
+  auto datagram = make_datagram(10);
+  datagram.media_data_length = 11;
+  MessageBuffer buffer;
+  buffer << datagram;
+  CHECK_EQ(decoder.push(buffer.get(), ignore, ignore),
+           DecodeStatus::InvalidLength);
+  CHECK(decoder.idle());
+
+  // A declared size past the limit is not read into
+  StreamDecoder bounded{ MAX_TRANSPORT_DATA_SIZE, 100 };
+  buffer << make_datagram(101);
+  auto oversized = buffer.get();
+  oversized.resize(oversized.size() - 10);
+  CHECK_EQ(bounded.push(oversized, ignore, ignore),
+           DecodeStatus::InvalidLength);
+  CHECK(bounded.idle());
+
+  const std::vector<uint8_t> unknown{ 0xFF, 0x00 };
+  CHECK_EQ(decoder.push(unknown, ignore, ignore), DecodeStatus::InvalidType);
+  CHECK(decoder.idle());
+}